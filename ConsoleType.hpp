@@ -1,38 +0,0 @@
-#pragma once
-
-enum class ConsoleType {
-    UNKNOWN,
-    // Nintendo
-    NES,
-    SNES,
-    N64,
-    GAMECUBE,
-    GAMEBOY,
-    GAMEBOY_COLOR,
-    GAMEBOY_ADVANCE,
-    DS,
-    
-    // Sony
-    PS1,
-    PS2,
-    PSP,
-    PSV,
-    
-    // Sega
-    MASTER_SYSTEM,
-    GENESIS,
-    SATURN,
-    DREAMCAST,
-    GAME_GEAR,
-    
-    // Atari
-    ATARI_2600,
-    ATARI_5200,
-    ATARI_7800,
-    
-    // Other
-    NEO_GEO,
-    NEO_GEO_POCKET,
-    WONDERSWAN,
-    TURBOGRAFX_16
-}; 
\ No newline at end of file
@@ -72,7 +72,9 @@ using ErrorCallback = std::function<void(const std::string&)>;
 
 class Emulator {
 public:
-    Emulator();
+    // A headless emulator never initializes SDL: no window, audio device
+    // or input polling, and no frame limiting
+    explicit Emulator(bool headless = false);
     virtual ~Emulator();
 
     // Console management
@@ -234,6 +236,7 @@ protected:
     std::unique_ptr<ConsoleEmulator> console;
     
     // Emulation state
+    bool headless;
     bool isRunning;
     std::vector<uint8_t> fileData;
 
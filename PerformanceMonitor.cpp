@@ -6,8 +6,6 @@
 #include <numeric>
 #include <thread>
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_ttf.h>
-#include <SDL2/SDL_net.h>
 #include <cmath>
 
 PerformanceMonitor::PerformanceMonitor()
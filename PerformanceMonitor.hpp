@@ -7,8 +7,10 @@
 #include <mutex>
 #include <atomic>
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_ttf.h>
-#include <SDL2/SDL_net.h>
+
+// Only handed through to the graph renderer; SDL_ttf itself is left to the
+// frontend that creates the font
+typedef struct _TTF_Font TTF_Font;
 
 class PerformanceMonitor {
 public:
@@ -224,8 +226,6 @@ private:
     size_t networkBytesReceived;
     double networkErrorRate;
     std::deque<double> networkHistory;
-    IPaddress serverAddress;
-    TCPsocket serverSocket;
 
     // Configuration
     size_t historySize;
@@ -7,7 +7,7 @@
 #include <iomanip>
 #include <SDL2/SDL.h>
 
-Emulator::Emulator() : running(false), paused(false), debugMode(false), rewinding(false),
+Emulator::Emulator(bool headless) : headless(headless), running(false), paused(false), debugMode(false), rewinding(false),
     debugStepping(false), debugPaused(false), audioEnabled(true), cheatsEnabled(false),
     rewindEnabled(false), rewindBufferSize(60), frameLimit(true), vsync(true),
     fullscreen(false), bilinearFiltering(false), performanceMonitoring(false),
@@ -59,7 +59,15 @@ bool Emulator::loadFile(const std::string& filepath) {
         }
     }
 
-    return console->loadROM(fileData);
+    if (!console->loadROM(fileData)) {
+        return false;
+    }
+
+    // Battery-backed Game Boy carts keep their RAM next to the ROM
+    if (auto* gameBoy = dynamic_cast<GameBoyEmulator*>(console.get())) {
+        gameBoy->setSaveFile(GameBoyEmulator::defaultSaveFile(filepath));
+    }
+    return true;
 }
 
 void Emulator::writeMemory(uint32_t address, uint8_t value) {
@@ -76,15 +84,23 @@ uint8_t Emulator::readMemory(uint32_t address) const {
 }
 
 void Emulator::initialize() {
-    // Initialize SDL
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMECONTROLLER) < 0) {
-        throw std::runtime_error("Failed to initialize SDL: " + std::string(SDL_GetError()));
+    // SDL is only brought up for the devices in use; a headless instance
+    // never touches it, so it runs without a display or audio device
+    if (!headless) {
+        Uint32 subsystems = SDL_INIT_VIDEO | SDL_INIT_GAMECONTROLLER;
+        if (audioEnabled) {
+            subsystems |= SDL_INIT_AUDIO;
+        }
+        if (SDL_Init(subsystems) < 0) {
+            throw std::runtime_error("Failed to initialize SDL: " + std::string(SDL_GetError()));
+        }
+
+        audio = std::make_unique<AudioSystem>();
+        video = std::make_unique<VideoSystem>();
+        input = std::make_unique<InputSystem>();
     }
 
     // Initialize systems
-    audio = std::make_unique<AudioSystem>();
-    video = std::make_unique<VideoSystem>();
-    input = std::make_unique<InputSystem>();
     memory = std::make_unique<MemorySystem>();
     cpu = std::make_unique<CPUSystem>();
     ppu = std::make_unique<PPUSystem>();
@@ -112,7 +128,9 @@ void Emulator::cleanup() {
     timer.reset();
 
     // Clean up SDL
-    SDL_Quit();
+    if (!headless) {
+        SDL_Quit();
+    }
 }
 
 void Emulator::runFrame() {
@@ -121,11 +139,17 @@ void Emulator::runFrame() {
     auto frameStart = std::chrono::high_resolution_clock::now();
 
     // Update input state
-    updateInputState();
+    if (!headless) {
+        updateInputState();
+    }
 
-    // Run CPU
+    // Run CPU, as one batch up to VBlank when a console core is attached
     auto cpuStart = std::chrono::high_resolution_clock::now();
-    cpu->run();
+    if (console) {
+        console->runUntilVBlank();
+    } else {
+        cpu->run();
+    }
     auto cpuEnd = std::chrono::high_resolution_clock::now();
     cpuTime = std::chrono::duration<double>(cpuEnd - cpuStart).count();
 
@@ -167,8 +191,8 @@ void Emulator::runFrame() {
     auto frameEnd = std::chrono::high_resolution_clock::now();
     frameTime = std::chrono::duration<double>(frameEnd - frameStart).count();
 
-    // Frame limiting
-    if (frameLimit) {
+    // Frame limiting; headless instances run as fast as possible
+    if (frameLimit && !headless) {
         double targetFrameTime = 1.0 / 60.0; // 60 FPS
         if (frameTime < targetFrameTime) {
             SDL_Delay(static_cast<uint32_t>((targetFrameTime - frameTime) * 1000.0));
@@ -0,0 +1,63 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "SM83.hpp"
+
+// Pre-decoded straight-line blocks of SM83 code.
+//
+// A block starts at a PC, runs to the first control-flow instruction (or the
+// end of its 256-byte page) and stores each instruction's handler and
+// immediate operand, so running it again skips fetch and decode. Blocks are
+// keyed by (bank, PC); the bank is the ROM or RAM bank mapped at PC when the
+// block was built. Writes to a page holding cached code invalidate every
+// block on that page.
+class BlockCache {
+public:
+    static constexpr int MAX_BLOCK_INSTRUCTIONS = 64;
+
+    struct Instruction {
+        SM83::Handler handler;
+        uint16_t operand;
+        uint8_t opcode;
+        uint8_t length;
+    };
+
+    // Native translation of a block. It advances the cycle counter itself,
+    // like the interpreted block loop.
+    using NativeCode = void (*)();
+
+    struct Block {
+        std::vector<Instruction> instructions;
+        uint16_t startPC;
+        uint16_t endPC;         // First address past the block
+        NativeCode native = nullptr;  // Set when the block is recompiled
+    };
+
+    static uint32_t makeKey(uint16_t bank, uint16_t pc) { return (static_cast<uint32_t>(bank) << 16) | pc; }
+
+    void clear();
+
+    // Returns nullptr on a miss
+    const Block* find(uint32_t key);
+    const Block* insert(uint32_t key, Block&& block);
+
+    // Code page tracking, used to route writes to those pages through the slow path
+    bool isCodePage(uint8_t page) const { return codePages[page]; }
+
+    // Drop all blocks on a page. Blocks are erased lazily on the next
+    // lookup so a block may safely invalidate itself while it is running.
+    void invalidatePage(uint8_t page);
+
+    size_t getBlockCount() const { return blocks.size(); }
+
+private:
+    std::unordered_map<uint32_t, Block> blocks;
+    std::array<std::vector<uint32_t>, 256> pageBlocks;
+    std::array<bool, 256> codePages{};
+    std::vector<uint8_t> pendingPages;
+
+    void flushInvalidated();
+};
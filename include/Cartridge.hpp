@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CowMemory.hpp"
+#include "RomImage.hpp"
+
+// GameBoy cartridge: ROM image, external RAM and the memory bank controller.
+//
+// The mapper is picked from the header byte at 0x147. Its registers are
+// written through writeRegister() (any write to 0000-7FFF); the current
+// banks are then exposed as pointers into the ROM image and RAM, which the
+// bus maps straight into its page table, so a bank switch repoints the
+// 4000-7FFF and A000-BFFF windows and never copies data. The ROM image is
+// shared with whoever loaded it; bank numbers past its end read as 0xFF. RAM that cannot
+// be mapped directly (MBC2's 4-bit RAM, MBC3 clock registers, RAM smaller
+// than a bank) is reached through readRam()/writeRam().
+//
+// RAM banks are copy-on-write pages, shared between a cartridge and its
+// copies until one of them writes the bank.
+class Cartridge {
+public:
+    enum class Mapper {
+        NONE,
+        MBC1,
+        MBC2,
+        MBC3,
+        MBC5
+    };
+
+    static constexpr size_t ROM_BANK_SIZE = 0x4000;
+    static constexpr size_t RAM_BANK_SIZE = 0x2000;
+
+    Cartridge();
+
+    // Returns false for mapper types that aren't supported
+    bool load(std::shared_ptr<const RomImage> image);
+
+    // Mapper registers to power-on state; RAM contents are kept
+    void reset();
+
+    // Returns true when the banks mapped into the address space changed
+    bool writeRegister(uint16_t address, uint8_t value);
+
+    // Windows for the page table. ramWindow() is null when A000-BFFF must
+    // go through readRam()/writeRam(); ramWriteWindow() is also null while
+    // the bank is shared with a copy, and changes once writeRam() unshares it.
+    const uint8_t* romBank0Window() const { return romWindow(romBank0); }
+    const uint8_t* romBankNWindow() const { return romWindow(romBankN); }
+    const uint8_t* ramWindow() const;
+    uint8_t* ramWriteWindow() const;
+
+    uint8_t readRam(uint16_t address) const;
+    void writeRam(uint16_t address, uint8_t value);
+
+    // Index into getRam() that A000-BFFF address reaches, or NO_RAM when
+    // it reaches clock registers or there is no RAM
+    static constexpr size_t NO_RAM = ~static_cast<size_t>(0);
+    size_t ramOffset(uint16_t address) const;
+
+    // MBC3 real-time clock, advanced in emulated time
+    void updateClock(uint64_t cycle);
+
+    Mapper getMapper() const { return mapper; }
+    std::string getMapperName() const;
+    bool hasBattery() const { return battery; }
+    uint16_t getRomBank0() const { return romBank0; }
+    uint16_t getRomBank() const { return romBankN; }
+    uint8_t getRamBank() const { return ramBankMapped; }
+    bool isRamEnabled() const { return ramEnabled; }
+
+    CowMemory& getRam() { return ram; }
+    const CowMemory& getRam() const { return ram; }
+
+    void saveState(std::ostream& out) const;
+    void loadState(std::istream& in);
+
+private:
+    std::shared_ptr<const RomImage> rom;
+    size_t romBanks;            // Banks in the image, counting a partial last one
+    std::vector<uint8_t> lastRomBank;   // Padded copy of a partial last bank
+    CowMemory ram;              // One page per bank
+    Mapper mapper;
+    bool battery;
+    bool hasClock;
+
+    // Mapper registers
+    bool ramEnabled;
+    uint16_t romBankRegister;   // As written; 0 is remapped by MBC1/2/3
+    uint8_t upperBits;          // MBC1 4000-5FFF
+    uint8_t ramBank;            // RAM bank, or MBC3 clock register 08-0C
+    bool bankingMode;           // MBC1 6000-7FFF
+
+    // Derived banks
+    uint16_t romBank0;
+    uint16_t romBankN;
+    uint8_t ramBankMapped;
+
+    // MBC3 clock: seconds, minutes, hours, day low, day high/flags
+    uint8_t clock[5];
+    uint8_t latchedClock[5];
+    uint8_t latchWrite;
+    uint64_t clockCycle;        // Emulated cycle the clock was last advanced to
+
+    void updateBanks();
+    const uint8_t* romWindow(uint16_t bank) const;
+    void tickClock(uint64_t seconds);
+};
@@ -0,0 +1,71 @@
+#pragma once
+#include "ConsoleEmulator.hpp"
+
+// Static-dispatch base for console cores.
+//
+// ConsoleEmulator stays the virtual boundary that Emulator talks to.
+// ConsoleCore implements its memory, step and batch entry points on top of
+// non-virtual members of the derived core, so the batch loops inline the
+// core's instruction and bus code. A core provides:
+//
+//   int runInstruction();                         // Cycles taken
+//   uint8_t busRead(uint32_t address) const;
+//   void busWrite(uint32_t address, uint8_t value);
+//   uint64_t getCyclesPerFrame() const;
+//   uint64_t cycleCount;
+//
+// and befriends ConsoleCore if those are private. Each core explicitly
+// instantiates its ConsoleCore in its own source file (and declares it
+// extern in its header), so the loops are compiled where the core's
+// instruction code is visible.
+template <class Derived, class Base = ConsoleEmulator>
+class ConsoleCore : public Base {
+public:
+    using Base::Base;
+
+    void step() final;
+    uint64_t runCycles(uint64_t cycles) final;
+    uint64_t runUntilVBlank() final;
+
+    uint8_t readMemory(uint32_t address) const final;
+    void writeMemory(uint32_t address, uint8_t value) final;
+
+private:
+    Derived& core() { return static_cast<Derived&>(*this); }
+    const Derived& core() const { return static_cast<const Derived&>(*this); }
+};
+
+template <class Derived, class Base>
+void ConsoleCore<Derived, Base>::step() {
+    core().cycleCount += core().runInstruction();
+}
+
+template <class Derived, class Base>
+uint64_t ConsoleCore<Derived, Base>::runCycles(uint64_t cycles) {
+    Derived& self = core();
+    uint64_t start = self.cycleCount;
+    uint64_t target = start + cycles;
+    while (self.cycleCount < target) {
+        self.cycleCount += self.runInstruction();
+    }
+    return self.cycleCount - start;
+}
+
+template <class Derived, class Base>
+uint64_t ConsoleCore<Derived, Base>::runUntilVBlank() {
+    // VBlank starts once every getCyclesPerFrame() cycles
+    const Derived& self = core();
+    uint64_t frameCycles = self.getCyclesPerFrame();
+    uint64_t nextFrame = (self.cycleCount / frameCycles + 1) * frameCycles;
+    return runCycles(nextFrame - self.cycleCount);
+}
+
+template <class Derived, class Base>
+uint8_t ConsoleCore<Derived, Base>::readMemory(uint32_t address) const {
+    return core().busRead(address);
+}
+
+template <class Derived, class Base>
+void ConsoleCore<Derived, Base>::writeMemory(uint32_t address, uint8_t value) {
+    core().busWrite(address, value);
+}
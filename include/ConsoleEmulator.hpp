@@ -4,6 +4,7 @@
 #include <string>
 #include <cstdint>
 #include "ConsoleType.hpp"
+#include "RomImage.hpp"
 
 class ConsoleEmulator {
 public:
@@ -11,9 +12,26 @@ public:
 
     // Core emulation functions
     virtual bool initialize() = 0;
-    virtual void step() = 0;
+    virtual void step() = 0;  // Single instruction, for the debugger
     virtual void reset() = 0;
-    virtual bool loadROM(const std::vector<uint8_t>& data) = 0;
+    // The image is shared, not copied: instances loading the same file
+    // all read from one mapping of it
+    virtual bool loadROM(std::shared_ptr<const RomImage> image) = 0;
+    bool loadROM(std::vector<uint8_t> data) {
+        return loadROM(RomImage::fromBuffer(std::move(data)));
+    }
+
+    // Batch execution. Each core runs its own inner loop and returns the
+    // number of cycles actually executed.
+    virtual uint64_t runCycles(uint64_t cycles) = 0;
+    virtual uint64_t runUntilVBlank() = 0;
+    virtual uint64_t runFrames(uint32_t frames) {
+        uint64_t cycles = 0;
+        for (uint32_t i = 0; i < frames; i++) {
+            cycles += runUntilVBlank();
+        }
+        return cycles;
+    }
 
     // Memory management
     virtual uint8_t readMemory(uint32_t address) const = 0;
@@ -23,6 +41,10 @@ public:
     virtual bool saveState(const std::string& filepath) = 0;
     virtual bool loadState(const std::string& filepath) = 0;
 
+    // In-memory copy of the running instance. RAM is shared copy-on-write
+    // with the parent, so this costs the pages either side dirties later.
+    virtual std::unique_ptr<ConsoleEmulator> fork() = 0;
+
     // Console specific information
     virtual ConsoleType getConsoleType() const = 0;
     virtual std::string getConsoleName() const = 0;
@@ -33,6 +55,6 @@ public:
 
 protected:
     // Common utility functions
-    virtual bool validateROM(const std::vector<uint8_t>& data) const = 0;
-    virtual bool detectConsoleType(const std::vector<uint8_t>& data) const = 0;
+    virtual bool validateROM(const RomImage& data) const = 0;
+    virtual bool detectConsoleType(const RomImage& data) const = 0;
 }; 
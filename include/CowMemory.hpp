@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Paged byte memory whose pages are shared copy-on-write between copies.
+//
+// Copying a CowMemory copies one reference per page. Both copies then see
+// every page as shared, and the first write to a shared page gives the
+// writer its own copy of that page, so the cost of a fork is paid per
+// page dirtied afterwards. A page that is known to be private has a cached
+// write pointer, which keeps write() to a single branch.
+//
+// A page's refcount only grows when its owner is copied, and copying drops
+// the owner's write pointers, so a cached write pointer is never stale.
+// Copies may run on different threads; copying one instance while another
+// thread writes to it is not supported.
+class CowMemory {
+public:
+    explicit CowMemory(size_t size = 0, unsigned pageShift = 12);
+    CowMemory(const CowMemory& other);
+    CowMemory& operator=(const CowMemory& other);
+    CowMemory(CowMemory&&) = default;
+    CowMemory& operator=(CowMemory&&) = default;
+
+    // Replace the contents with size bytes of value, all pages private
+    void assign(size_t size, uint8_t value = 0);
+    void assign(const uint8_t* data, size_t size);
+    void fill(uint8_t value);
+
+    size_t size() const { return memorySize; }
+    size_t pageSize() const { return size_t(1) << pageShift; }
+
+    uint8_t read(size_t address) const {
+        return pages[address >> pageShift][address & pageMask];
+    }
+
+    void write(size_t address, uint8_t value) {
+        uint8_t* page = writablePages[address >> pageShift];
+        if (page) {
+            page[address & pageMask] = value;
+        } else {
+            writeShared(address, value);
+        }
+    }
+
+    // Host pointers to the page holding address. The write pointer is null
+    // while the page is shared; makeWritable() unshares it.
+    const uint8_t* readPointer(size_t address) const { return pages[address >> pageShift].get(); }
+    uint8_t* writePointer(size_t address) const { return writablePages[address >> pageShift]; }
+    uint8_t* makeWritable(size_t address);
+
+    // Bulk copies, for save states
+    void copyTo(uint8_t* data) const;
+    void copyFrom(const uint8_t* data);
+
+    // Pages currently referenced by another copy
+    size_t sharedPageCount() const;
+
+private:
+    using Page = std::shared_ptr<uint8_t[]>;
+
+    size_t memorySize;
+    unsigned pageShift;
+    size_t pageMask;
+    std::vector<Page> pages;
+    // Cached per copy; dropped on both sides when pages become shared
+    mutable std::vector<uint8_t*> writablePages;
+
+    Page allocatePage(uint8_t value) const;
+    void writeShared(size_t address, uint8_t value);
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <unordered_map>
+
+// Breakpoints and watchpoints for a 16-bit address space.
+//
+// Whether an address is hooked is one bit in a 64 Kbit map per access
+// kind, and isArmed() says whether any hook is set at all, so the CPU tests
+// a single flag until the debugger actually places something. Callbacks
+// are kept out of line and only looked up once a bit is found set.
+// Per-page counts let the bus keep pages without watchpoints on its fast
+// path.
+//
+// Hooks fire from inside recompiled blocks, which have no unwind info, so
+// an exception thrown by a callback must not propagate through them.
+// notify() catches it, raises the stop flag so the running block ends, and
+// keeps it for rethrowPending(), which the emulator calls once it is back
+// in its own frames.
+class DebugHooks {
+public:
+    enum Access : uint8_t {
+        EXECUTE = 0,
+        READ = 1,
+        WRITE = 2
+    };
+    static constexpr int ACCESS_KINDS = 3;
+
+    using Callback = std::function<void(uint16_t address, uint8_t value)>;
+
+    DebugHooks();
+
+    bool isArmed() const { return armed; }
+
+    bool isSet(Access access, uint16_t address) const {
+        return (bits[access][address >> 6] >> (address & 63)) & 1;
+    }
+
+    bool watchesPage(Access access, uint8_t page) const {
+        return pageCounts[access][page] != 0;
+    }
+
+    // Whether any address in [start, end) is hooked
+    bool anySet(Access access, uint16_t start, uint32_t end) const;
+
+    // A null callback still marks the address; hits are then only reported
+    // through the optional default handler
+    void set(Access access, uint16_t address, Callback callback = nullptr);
+    void clear(Access access, uint16_t address);
+    void clearAll(Access access);
+    void clearAll();
+
+    void setDefaultHandler(Callback handler) { defaultHandler = std::move(handler); }
+
+    // Call the hook for address; the caller has checked isSet()
+    void notify(Access access, uint16_t address, uint8_t value) const noexcept;
+
+    // Set to true when a callback throws
+    void setStopFlag(bool* flag) { stopFlag = flag; }
+
+    // Throw the first exception a callback raised since the last call, if any
+    void rethrowPending() const {
+        if (pending) {
+            throwPending();
+        }
+    }
+
+private:
+    std::array<std::array<uint64_t, 1024>, ACCESS_KINDS> bits;
+    std::array<std::array<uint16_t, 256>, ACCESS_KINDS> pageCounts;
+    std::array<std::unordered_map<uint16_t, Callback>, ACCESS_KINDS> callbacks;
+    Callback defaultHandler;
+    uint32_t hookCount;
+    bool armed;
+    bool* stopFlag;
+    mutable std::exception_ptr pending;
+
+    [[noreturn]] void throwPending() const;
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "SM83.hpp"
+
+// Cache of disassembled SM83 instructions for the debugger.
+//
+// Lines are keyed by (bank, address) like BlockCache. ROM bytes never
+// change under a given bank, so ROM lines are returned as cached. A line in
+// RAM keeps the bytes it was decoded from and is redecoded when they no
+// longer match, which catches every write to RAM-resident code without
+// taking the memory bus off its fast path.
+class Disassembler {
+public:
+    static constexpr size_t MAX_LINES = 1 << 16;
+
+    struct Line {
+        uint16_t bank;
+        uint16_t address;
+        uint8_t bytes[3];
+        uint8_t length;
+        std::string text;
+    };
+
+    // peek(address) reads a byte without side effects
+    template <class Peek>
+    const Line& disassemble(uint16_t bank, uint16_t address, Peek peek) {
+        uint32_t key = (static_cast<uint32_t>(bank) << 16) | address;
+        auto it = lines.find(key);
+        if (it != lines.end() && (address < 0x8000 || matches(it->second, peek))) {
+            return it->second;
+        }
+
+        if (lines.size() >= MAX_LINES) {
+            lines.clear();
+        }
+
+        Line line;
+        line.bank = bank;
+        line.address = address;
+        line.bytes[0] = peek(address);
+        line.length = SM83::instructionLength(line.bytes[0]);
+        line.bytes[1] = line.length > 1 ? peek(address + 1) : 0;
+        line.bytes[2] = line.length > 2 ? peek(address + 2) : 0;
+        uint16_t operand = line.length == 3 ? line.bytes[1] | (line.bytes[2] << 8) : line.bytes[1];
+        line.text = SM83::disassemble(address, line.bytes[0], operand);
+        return lines[key] = std::move(line);
+    }
+
+    void clear() { lines.clear(); }
+    size_t size() const { return lines.size(); }
+
+private:
+    std::unordered_map<uint32_t, Line> lines;
+
+    template <class Peek>
+    static bool matches(const Line& line, Peek peek) {
+        for (uint8_t i = 0; i < line.length; i++) {
+            if (peek(line.address + i) != line.bytes[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
@@ -6,6 +6,7 @@
 #include <stdexcept>
 #include <cstdint>
 #include <unordered_map>
+#include <atomic>
 #include "ConsoleType.hpp"
 #include "ConsoleEmulator.hpp"
 
@@ -28,8 +29,9 @@ public:
     
     // Emulation control
     void initialize();
-    void step();
-    void run();
+    void step();            // Single instruction, for the debugger
+    void run();             // Runs frame by frame until stop()
+    void runFrames(uint32_t frames);
     void stop();
     void reset();
 
@@ -42,10 +44,10 @@ private:
     std::unique_ptr<ConsoleEmulator> console;
     
     // Emulation state
-    bool isRunning;
-    std::vector<uint8_t> fileData;
+    std::atomic<bool> isRunning;  // Cleared by stop(), possibly from another thread
+    std::shared_ptr<const RomImage> fileData;  // Mapped read-only, shared with the core
 
     // Helper functions
-    ConsoleType detectConsoleType(const std::vector<uint8_t>& data) const;
+    ConsoleType detectConsoleType(const RomImage& data) const;
     std::unique_ptr<ConsoleEmulator> createConsoleEmulator(ConsoleType type) const;
 }; 
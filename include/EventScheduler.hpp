@@ -0,0 +1,52 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+
+// Cycle-timestamped event queue.
+//
+// Each event id has at most one pending occurrence; scheduling an id that is
+// already pending moves it. Events are kept in a binary min-heap ordered by
+// timestamp, with a position index per id so cancel/reschedule are O(log n).
+class EventScheduler {
+public:
+    static constexpr int MAX_EVENTS = 16;
+    static constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+
+    EventScheduler();
+
+    void reset();
+
+    // Event management
+    void schedule(int id, uint64_t timestamp);
+    void cancel(int id);
+    bool isScheduled(int id) const { return position[id] >= 0; }
+    uint64_t getTimestamp(int id) const;
+
+    // Earliest pending timestamp, or NEVER
+    uint64_t nextEventTime() const { return count ? heap[0].timestamp : NEVER; }
+
+    // Remove the earliest event and return its id (-1 when empty)
+    int popEvent(uint64_t& timestamp);
+
+    // Save states: the pending timestamp of every id. Loading replaces
+    // whatever is queued.
+    void saveState(std::ostream& out) const;
+    void loadState(std::istream& in);
+
+private:
+    struct Entry {
+        uint64_t timestamp;
+        int id;
+    };
+
+    std::array<Entry, MAX_EVENTS> heap;
+    std::array<int, MAX_EVENTS> position;  // Heap slot per id, -1 when idle
+    int count;
+
+    void siftUp(int slot);
+    void siftDown(int slot);
+    void place(int slot, const Entry& entry);
+    void removeAt(int slot);
+};
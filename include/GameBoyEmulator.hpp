@@ -1,25 +1,122 @@
 #pragma once
 #include "ConsoleEmulator.hpp"
 #include <array>
+#include <bitset>
+#include <unordered_map>
+#include <vector>
+#include <map>
+#include <string>
+#include <memory>
+#include <functional>
+#include "EventScheduler.hpp"
+#include "BlockCache.hpp"
+#include "Recompiler.hpp"
+#include "TraceBuffer.hpp"
+#include "DebugHooks.hpp"
+#include "Profiler.hpp"
+#include "Disassembler.hpp"
+#include "Cartridge.hpp"
+#include "SaveRam.hpp"
+#include "TileCache.hpp"
+#include "SpriteIndex.hpp"
+
+// GameBoy-specific constants
+constexpr uint16_t ROM_BANK_SIZE = 0x4000;
+constexpr uint16_t RAM_BANK_SIZE = 0x2000;
+constexpr uint16_t VRAM_SIZE = 0x2000;
+constexpr uint16_t OAM_SIZE = 0xA0;
+constexpr uint16_t IO_SIZE = 0x80;
+constexpr uint16_t HRAM_SIZE = 0x7F;
+
+// GameBoy memory bus pages
+constexpr int MEMORY_PAGE_SHIFT = 8;
+constexpr uint16_t MEMORY_PAGE_SIZE = 0x100;
+constexpr int MEMORY_PAGE_COUNT = 0x100;
+
+// GameBoy LCD
+constexpr int SCREEN_WIDTH = 160;
+constexpr int SCREEN_HEIGHT = 144;
+constexpr int MAX_SPRITES_PER_LINE = 10;
+
+// GameBoy PPU timing (T-cycles)
+constexpr int OAM_SCAN_CYCLES = 80;
+constexpr int PIXEL_TRANSFER_CYCLES = 172;
+constexpr int HBLANK_CYCLES = 204;
+constexpr int SCANLINE_CYCLES = 456;
+constexpr int DMA_TRANSFER_CYCLES = 640;
+constexpr int FRAME_CYCLES = SCANLINE_CYCLES * 154;
+
+// GameBoy Color specific constants
+constexpr uint8_t GBC_PALETTE_COUNT = 8;
+constexpr uint8_t GBC_SPRITE_PALETTE_COUNT = 8;
+constexpr uint8_t GBC_DMA_TRANSFER_SIZE = 0xA0;
+
+// GameBoy memory map
+enum class MemoryRegion {
+    ROM_BANK_0,
+    ROM_BANK_N,
+    VRAM,
+    EXTERNAL_RAM,
+    WRAM_BANK_0,
+    WRAM_BANK_N,
+    ECHO_RAM,
+    OAM,
+    UNUSED,
+    IO,
+    HRAM,
+    INTERRUPT_ENABLE
+};
+
+// GameBoy PPU modes
+enum class PPUMode {
+    HBLANK,
+    VBLANK,
+    OAM_SCAN,
+    PIXEL_TRANSFER
+};
+
+// GameBoy interrupt types
+enum class InterruptType {
+    VBLANK,
+    LCD_STAT,
+    TIMER,
+    SERIAL,
+    JOYPAD
+};
+
+// CPU execution strategy, selectable at runtime
+enum class ExecutionMode {
+    INTERPRETER,    // Fetch and decode every instruction
+    BLOCK_CACHE,    // Run pre-decoded basic blocks
+    DYNAREC         // Run blocks recompiled to x86-64 (Linux x86-64 only)
+};
 
 class GameBoyEmulator : public ConsoleEmulator {
+    friend struct SM83;
+
 public:
     GameBoyEmulator();
-    ~GameBoyEmulator() override = default;
+    ~GameBoyEmulator() override;
 
     // Core emulation functions
     bool initialize() override;
     void step() override;
     void reset() override;
-    bool loadROM(const std::vector<uint8_t>& data) override;
+    using ConsoleEmulator::loadROM;
+    bool loadROM(std::shared_ptr<const RomImage> image) override;
+
+    // Batch execution
+    uint64_t runCycles(uint64_t cycles) override;
+    uint64_t runUntilVBlank() override;
 
     // Memory management
     uint8_t readMemory(uint32_t address) const override;
     void writeMemory(uint32_t address, uint8_t value) override;
 
     // State management
-    bool saveState(const std::string& filepath) override;
-    bool loadState(const std::string& filepath) override;
+    bool saveState(const std::string& filename = "") override;
+    bool loadState(const std::string& filename = "") override;
+    std::unique_ptr<ConsoleEmulator> fork() override;
 
     // Console specific information
     ConsoleType getConsoleType() const override { return ConsoleType::GAMEBOY; }
@@ -29,32 +126,525 @@ public:
     uint32_t getMinimumMemorySize() const override { return 32 * 1024; } // 32KB
     uint32_t getRecommendedMemorySize() const override { return 64 * 1024; } // 64KB
 
+    // Debug functions
+    void setBreakpoint(uint16_t address);
+    void clearBreakpoint(uint16_t address);
+    void clearAllBreakpoints();
+
+    // Register access
+    uint16_t getPC() const;
+    uint16_t getSP() const;
+    uint8_t getA() const;
+    uint8_t getB() const;
+    uint8_t getC() const;
+    uint8_t getD() const;
+    uint8_t getE() const;
+    uint8_t getH() const;
+    uint8_t getL() const;
+    uint16_t getAF() const;
+    uint16_t getBC() const;
+    uint16_t getDE() const;
+    uint16_t getHL() const;
+
+    // Status flags
+    bool getZeroFlag() const;
+    bool getSubtractFlag() const;
+    bool getHalfCarryFlag() const;
+    bool getCarryFlag() const;
+
+    // Event callbacks
+    using FrameCallback = std::function<void(const std::vector<uint8_t>&)>;
+    void setFrameCallback(FrameCallback callback);
+
+    // Joypad, active low as read through P1: buttons are A, B, Select,
+    // Start and directions are Right, Left, Up, Down from bit 0
+    void setJoypad(uint8_t buttons, uint8_t directions);
+
+    // GameBoy-specific features
+    void setColorMode(bool enabled);
+    bool isColorMode() const;
+    void setDoubleSpeed(bool enabled);
+    bool isDoubleSpeed() const;
+    void setInfrared(bool enabled);
+    bool isInfrared() const;
+    void setRumble(bool enabled);
+    bool isRumble() const;
+
+    // Battery RAM persistence. Changes are written in the background about
+    // once a second; flushSaveFile() writes them immediately. loadROM()
+    // closes the file, so set it after each load; defaultSaveFile() gives
+    // the usual name next to the ROM (game.gb -> game.sav).
+    bool setSaveFile(const std::string& filepath);
+    void flushSaveFile();
+    static std::string defaultSaveFile(const std::string& romPath);
+
+    // Frame skipping for fast-forward and headless runs. Only every
+    // interval-th frame is drawn, and with requireCallback none are drawn
+    // while no frame callback is set. Skipped frames still run the PPU
+    // modes, LY/LYC and STAT/VBlank interrupts with exact timing.
+    void setFrameSkip(uint32_t interval, bool requireCallback = false);
+    uint32_t getFrameSkip() const { return frameSkip; }
+
+    // Memory management
+    void setBreakpoint(uint16_t address, std::function<void()> callback);
+    void setWatchpoint(uint16_t address, std::function<void(uint8_t)> callback);      // Writes
+    void setReadWatchpoint(uint16_t address, std::function<void(uint8_t)> callback);
+    void clearWatchpoint(uint16_t address);
+
+    // Debugging tools
+    void stepInstruction();
+    void setTraceLogging(bool enabled);
+    bool isTraceLogging() const;
+    bool setTraceFile(const std::string& filepath);  // Also stream the trace to disk
+    void closeTraceFile();
+    std::string getDisassembly(uint16_t address) const;
+    std::vector<Disassembler::Line> getDisassembly(uint16_t address, size_t count) const;  // count instructions from address
+    const TraceBuffer& getTraceLog() const { return traceLog; }  // Format with TraceBuffer::format
+    void clearTraceLog();
+
+    // Graphics debugging
+    void setTileViewer(bool enabled);
+    bool isTileViewer() const;
+    void setSpriteViewer(bool enabled);
+    bool isSpriteViewer() const;
+    void setPaletteViewer(bool enabled);
+    bool isPaletteViewer() const;
+    void setVRAMViewer(bool enabled);
+    bool isVRAMViewer() const;
+
+    // Audio debugging
+    void setAudioChannelEnabled(uint8_t channel, bool enabled);
+    bool isAudioChannelEnabled(uint8_t channel) const;
+    void setAudioWaveform(uint8_t channel, const std::array<uint8_t, 32>& waveform);
+    std::array<uint8_t, 32> getAudioWaveform(uint8_t channel) const;
+
+    // Performance monitoring
+    void setPerformanceCounter(bool enabled);
+    bool isPerformanceCounter() const;
+    uint64_t getInstructionCount() const;
+    uint64_t getCycleCount() const;
+    uint64_t getUnknownOpcodeCount() const;
+    void setExecutionMode(ExecutionMode mode);
+    ExecutionMode getExecutionMode() const { return executionMode; }
+    double getAverageCyclesPerFrame() const;
+
+    // Execution profiler, off by default. Runs the interpreter while on.
+    void setProfiling(bool enabled);
+    bool isProfiling() const { return profiling; }
+    const Profiler& getProfiler() const { return profiler; }
+    void clearProfile() { profiler.clear(); }
+    std::string getProfileReport(size_t limit) const;
+    bool writeProfileHeatmap(const std::string& filepath) const { return profiler.writeHeatmap(filepath); }
+
 protected:
-    bool validateROM(const std::vector<uint8_t>& data) const override;
-    bool detectConsoleType(const std::vector<uint8_t>& data) const override;
+    // Used by fork(); memory is shared copy-on-write, everything else is
+    // copied except the save file, trace file and compiled code
+    GameBoyEmulator(const GameBoyEmulator& other);
+
+    bool validateROM(const RomImage& data) const override;
+    bool detectConsoleType(const RomImage& data) const override;
 
 private:
-    // GameBoy specific memory regions
-    std::array<uint8_t, 0x10000> memory;  // 64KB total memory
-    std::vector<uint8_t> cartridgeROM;    // Cartridge ROM data
-    
-    // CPU registers
-    struct {
-        uint8_t a, f;  // Accumulator & flags
-        uint8_t b, c;  // BC pair
-        uint8_t d, e;  // DE pair
-        uint8_t h, l;  // HL pair
-        uint16_t sp;   // Stack pointer
-        uint16_t pc;   // Program counter
+    // CPU registers (little-endian pairs: the low byte is the second name)
+    struct Registers {
+        union { struct { uint8_t f, a; }; uint16_t af; };
+        union { struct { uint8_t c, b; }; uint16_t bc; };
+        union { struct { uint8_t e, d; }; uint16_t de; };
+        union { struct { uint8_t l, h; }; uint16_t hl; };
+        uint16_t sp;
+        uint16_t pc;
     } registers;
 
-    // GPU registers
+    // Lazily evaluated flags, see getZeroFlag(). F in registers is only
+    // brought up to date when the whole register is needed (e.g. save states).
+    struct {
+        uint8_t zero;           // Z is set when this is 0
+        bool subtract;          // N
+        uint32_t halfSource;    // H is set when halfSource & halfMask
+        uint32_t halfMask;
+        uint32_t carrySource;   // C is set when carrySource & carryMask
+        uint32_t carryMask;
+    } lazyFlags;
+
+    // CPU state
+    bool halted;
+    bool stopped;
+    uint64_t unknownOpcodeCount;
+
+    // Execution strategy and block cache
+    ExecutionMode executionMode;
+    BlockCache blockCache;
+    std::unique_ptr<Recompiler> recompiler;
+    bool breakBlock;        // Set when a running block must stop early
+    uint64_t blockDeadline; // Next event time as the running block started
+
+    // GameBoy-specific memory
+    Cartridge cartridge;
+    SaveRam saveRam;
+    // VRAM, work RAM and cartridge RAM are shared copy-on-write with forks.
+    // VRAM is a single page so the renderer can index it directly.
+    CowMemory vram;
+    CowMemory wramBank0;
+    CowMemory wramBankN;
+    std::array<uint8_t, OAM_SIZE> oam;
+    std::array<uint8_t, IO_SIZE> io;
+    std::array<uint8_t, HRAM_SIZE> hram;
+
+    // Memory bus page table. Each 256-byte page points straight at host
+    // memory (pre-offset so page[address & 0xFF] is the byte), or is null
+    // when the access needs side effects: I/O, ROM bank registers, VRAM/OAM
+    // writes, disabled cartridge RAM and writes to memory still shared with
+    // a fork take the slow path.
+    std::array<const uint8_t*, MEMORY_PAGE_COUNT> readPages;
+    std::array<uint8_t*, MEMORY_PAGE_COUNT> writePages;
+
+    // Pages held off the fast path because they contain a watchpoint; the
+    // slow path reads and writes through these
+    std::array<const uint8_t*, MEMORY_PAGE_COUNT> watchedReadPages;
+    std::array<uint8_t*, MEMORY_PAGE_COUNT> watchedWritePages;
+
+    // GameBoy-specific state
+    bool batteryBacked;
+    std::string romPath;
+    std::string savePath;
+
+    // PPU state
+    PPUMode ppuMode;
+    uint8_t ppuModeClock;
+    uint8_t ppuLine;
+    uint8_t ppuScrollX;
+    uint8_t ppuScrollY;
+    uint8_t ppuWindowX;
+    uint8_t ppuWindowY;
+    bool ppuWindowEnabled;
+    bool ppuEnabled;
+    bool ppuBackgroundEnabled;
+    bool ppuSpritesEnabled;
+    bool ppuTallSprites;    // LCDC.2, 8x16 sprites
+    uint8_t ppuBackgroundPalette;
+    std::array<uint8_t, 8> ppuSpritePalettes;
+    TileCache tileCache;
+    std::vector<uint8_t> frameBuffer;   // Shades 0-3, SCREEN_WIDTH x SCREEN_HEIGHT
+    FrameCallback frameCallback;        // Given frameBuffer after each drawn frame
+    uint32_t frameSkip;                 // Draw one frame in this many
+    bool frameSkipRequiresCallback;
+    bool renderingFrame;                // Whether the current frame is drawn
+    std::array<uint8_t, SCREEN_WIDTH> lineIndices;  // Current line's background color indices
+    uint8_t windowLine;     // Window row drawn next; only lines that show the window advance it
+
+    // Sprites on the current line, in drawing priority order
+    struct Sprite {
+        int y, x;
+        uint8_t tile;
+        uint8_t attributes;
+    };
+    std::array<Sprite, MAX_SPRITES_PER_LINE> sprites;
+    int spriteCount;
+    SpriteIndex spriteIndex;    // Per-line bins, kept current by OAM writes
+
+    // LCD registers
+    struct {
+        uint8_t stat;   // Mode and coincidence bits are maintained by the PPU events
+        uint8_t ly;
+        uint8_t lyc;
+        uint8_t scx, scy;
+        uint8_t wx, wy;
+        uint8_t bgp, obp0, obp1;
+    } graphics;
+
+    // OAM DMA state
+    struct {
+        bool active;
+        uint16_t source;
+        uint16_t destination;
+        uint16_t length;
+        uint16_t remaining;
+    } dma;
+
+    // Timer state. DIV and TIMA are derived from the cycle counter on read;
+    // only the TIMA overflow is scheduled.
+    uint16_t timerDivider;
+    uint8_t timerCounter;      // TIMA as of timerSyncCycle
+    uint8_t timerModulo;
+    bool timerEnabled;
+    uint8_t timerClock;
+    uint64_t dividerBase;      // Cycle at which DIV was last reset
+    uint64_t timerSyncCycle;
+
+    // Scheduled hardware events
+    enum Event {
+        EVENT_PPU_MODE,
+        EVENT_TIMER_OVERFLOW,
+        EVENT_DMA_COMPLETE
+    };
+    EventScheduler scheduler;
+
+    // Interrupt state
+    struct {
+        uint8_t flags;       // IF (0xFF0F)
+        uint8_t enable;      // IE (0xFFFF)
+        bool master;         // IME
+        bool enablePending;  // EI takes effect after the next instruction
+    } interrupts;
+
+    // Joypad lines, active low
     struct {
-        uint8_t lcdc;  // LCD Control
-        uint8_t stat;  // LCD Status
-        uint8_t ly;    // LCD Y-Coordinate
-    } gpu;
+        uint8_t buttons;
+        uint8_t directions;
+    } input;
 
+    // Debug state
+    DebugHooks debugHooks;
+    bool debugStepping;
+    bool debugPaused;
+
+    // Feature flags
+    bool colorMode;
+    bool doubleSpeed;
+    bool infrared;
+    bool rumble;
+    bool traceLogging;
+    bool profiling;
+    bool tileViewer;
+    bool spriteViewer;
+    bool paletteViewer;
+    bool vramViewer;
+    bool performanceCounter;
+
+    // Debugging state
+    TraceBuffer traceLog;
+    Profiler profiler;
+    mutable Disassembler disassembler;  // Debugger-side cache
+    uint64_t instructionCount;
+    uint64_t cycleCount;
+    uint64_t frameCount;
+
+    // Audio state
+    std::array<bool, 4> audioChannels;
+    std::array<std::array<uint8_t, 32>, 4> audioWaveforms;
+
+    // CPU
+    int executeInstruction();
+    void recordTrace(uint8_t opcode, uint16_t operand, uint8_t length);
+    int executeProfiled();
+    int handleInterrupts();
+    uint16_t readWord(uint16_t address) const;
+    void writeWord(uint16_t address, uint16_t value);
+    void pushWord(uint16_t value);
+    uint16_t popWord();
+    void setAF(uint16_t value);
+
+    // Flags
+    uint8_t getFlags() const;
+    void setFlags(uint8_t value);
+    void setZeroFlag(bool set);
+    void setSubtractFlag(bool set);
+    void setHalfCarryFlag(bool set);
+    void setCarryFlag(bool set);
+
+    // ALU operations
+    uint8_t inc(uint8_t value);
+    uint8_t dec(uint8_t value);
+    void add8(uint8_t value);
+    void adc8(uint8_t value);
+    void sub8(uint8_t value);
+    void sbc8(uint8_t value);
+    void and8(uint8_t value);
+    void xor8(uint8_t value);
+    void or8(uint8_t value);
+    void cp8(uint8_t value);
+    uint16_t add16(uint16_t a, uint16_t b);
+    uint16_t addSP(int8_t offset);
+    void daa();
+
+    // Rotate, shift and bit operations
+    uint8_t rlc(uint8_t value);
+    uint8_t rrc(uint8_t value);
+    uint8_t rl(uint8_t value);
+    uint8_t rr(uint8_t value);
+    uint8_t sla(uint8_t value);
+    uint8_t sra(uint8_t value);
+    uint8_t swap(uint8_t value);
+    uint8_t srl(uint8_t value);
+    void bit(uint8_t index, uint8_t value);
+    void setShiftFlags(uint8_t result, uint8_t value, uint8_t carryBit);
+
+    // Block cache
+    int executeBlock();
+    const BlockCache::Block* compileBlock(uint32_t key);
+    uint16_t getBankForAddress(uint16_t address) const;
+
+    // Scheduling
+    int runInstruction();
+    void runUntil(uint64_t targetCycle);
+    bool skipIdle(uint64_t deadline);
+    void processEvents();
     void initializeRegisters();
-    void executeInstruction();
+    void initializeHardware();
+
+    // PPU events
+    void onPPUModeEvent(uint64_t timestamp);
+    void setPPUMode(PPUMode mode);
+    void updateLCDControl();
+
+    // Timer
+    uint8_t getDivider() const;
+    uint8_t getTimerCounter() const;
+    void syncTimer();
+    void scheduleTimerOverflow();
+    void onTimerOverflow(uint64_t timestamp);
+
+    // DMA
+    void onDMAComplete();
+
+    // Memory bus
+    uint8_t busRead(uint16_t address) const {
+        const uint8_t* page = readPages[address >> MEMORY_PAGE_SHIFT];
+        return page ? page[address & 0xFF] : readMemorySlow(address);
+    }
+    void busWrite(uint16_t address, uint8_t value) {
+        uint8_t* page = writePages[address >> MEMORY_PAGE_SHIFT];
+        if (page) {
+            page[address & 0xFF] = value;
+        } else {
+            writeMemorySlow(address, value);
+        }
+    }
+    uint8_t readMemorySlow(uint16_t address) const;
+    uint8_t readUnmapped(uint16_t address) const;
+    uint8_t peekMemory(uint16_t address) const;  // No watchpoints or side effects
+    void writeMemorySlow(uint16_t address, uint8_t value);
+    void mapPages(uint16_t start, uint32_t end, uint8_t* base, bool writable);
+    void mapPages(uint16_t start, uint32_t end, const CowMemory& memory, bool writable);
+    void mapReadOnlyPages(uint16_t start, uint32_t end, const uint8_t* base);
+    void unmapPages(uint16_t start, uint32_t end);
+    void updateMemoryMap();
+    void updateDebugHooks();
+    void mapCartridge();
+    void remapCartridge();
+    void protectPages(int first, int end);
+    void commitSaveRam(bool force);
+    void switchBanks(uint16_t address, uint8_t value);
+
+    // I/O registers
+    uint8_t readIO(uint8_t address) const;
+    void writeIO(uint8_t address, uint8_t value);
+
+    // Helper functions
+    void processDMA();
+    void updateJoypad();
+    void updateSerial();
+    void updateAudio();
+    void renderScanline();
+    void beginFrame();
+    void renderBackground();
+    void renderWindow();
+    void renderTileRow(const uint8_t* mapRow, int mapX, int skip, int tileY, int x);
+    void renderSprites();
+    void findSpritesForScanline();
+    uint8_t getPaletteColor(uint8_t palette, uint8_t color);
+    void setPixel(int x, int y, uint8_t color);
+    uint8_t getPixel(int x, int y) const;
+    void updateTileData(uint16_t address);
+    void updateTileMaps();
+    void updateOAM(uint8_t offset);
+    void updatePalettes();
+    void updateWindow();
+    void updateSprites();
+    void updateBackground();
+    void updateScroll();
+    void updateWindowPosition();
+    void updateLCDStatus();
+    void updateInterrupts();
+    void updateTimers();
+    void updateInput();
+    void updateDMA();
+    void updateHDMA();
+    void updateVRAM();
+    void updateIO();
+    void updateHRAM();
+    void updateInterruptEnable();
+    void updateInterruptFlags();
+    void updateTimerControl();
+    void updateTimerModulo();
+    void updateTimerCounter();
+    void updateDivider();
+    void updateSerialControl();
+    void updateSerialData();
+    void updateAudioControl();
+    void updateAudioChannel1();
+    void updateAudioChannel2();
+    void updateAudioChannel3();
+    void updateAudioChannel4();
+    void updateAudioOutput();
+    void updateAudioVolume();
+    void updateAudioPanning();
+    void updateAudioSampleRate();
+    void updateAudioBuffer();
+    void updateAudioCallback();
+    void updateFrameCallback();
+    void updateInputCallback();
+    void updateDebugCallback();
+    void updatePerformance();
+    void updateState();
+    void updateSaveState();
+    void updateLoadState();
+    void updateBreakpoints();
+    void updateDebugMode();
+    void updatePause();
+    void updateResume();
+    void updateStop();
+    void updateReset();
+    void updateInitialize();
+    void updateLoadROM();
+    void updateRunFrame();
+    void updateStep();
+    void updateStepFrame();
+    void updateBreakpoint();
+    void updateContinueExecution();
+    void updateSetBreakpoint();
+    void updateClearBreakpoint();
+    void updateClearAllBreakpoints();
+    void updateReadMemory();
+    void updateWriteMemory();
+    void updateDumpMemory();
+    void updateGetPC();
+    void updateGetSP();
+    void updateGetA();
+    void updateGetB();
+    void updateGetC();
+    void updateGetD();
+    void updateGetE();
+    void updateGetH();
+    void updateGetL();
+    void updateGetAF();
+    void updateGetBC();
+    void updateGetDE();
+    void updateGetHL();
+    void updateGetZeroFlag();
+    void updateGetSubtractFlag();
+    void updateGetHalfCarryFlag();
+    void updateGetCarryFlag();
+    void updateGetSystemName();
+    void updateGetROMName();
+    void updateGetROMSize();
+    void updateGetROMMapper();
+    void updateGetROMSaveType();
+    void updateGetROMRegion();
+    void updateGetFPS();
+    void updateGetFrameTime();
+    void updateGetCPUTime();
+    void updateGetPPUTime();
+    void updateGetAPUTime();
+    void updateSetFrameCallback();
+    void updateSetAudioCallback();
+    void updateSetInputCallback();
+    void updateSetDebugCallback();
+    void updatePerformanceCounters();
+    void renderDebugViews();
+    void renderTileViewer();
+    void renderSpriteViewer();
+    void renderPaletteViewer();
+    void renderVRAMViewer();
+    void renderPerformanceCounter();
 }; 
@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ConsoleEmulator.hpp"
+
+// Runs many independent console instances in parallel.
+//
+// Each instance advances in one-frame jobs. Every worker thread has its own
+// job deque: it takes work from the back of its own deque and, when that is
+// empty, steals from the front of another worker's. A finished frame
+// re-queues the instance's next frame on the same worker, so an instance
+// tends to stay on one core while idle workers steal whatever is left.
+// A worker with nothing to run or steal sleeps until a job is re-queued or
+// the round ends.
+class InstancePool {
+public:
+    explicit InstancePool(size_t threadCount = std::thread::hardware_concurrency());
+    ~InstancePool();
+
+    InstancePool(const InstancePool&) = delete;
+    InstancePool& operator=(const InstancePool&) = delete;
+
+    // Instance management (not while runFrames() is in progress)
+    size_t addInstance(std::unique_ptr<ConsoleEmulator> instance);
+    ConsoleEmulator& getInstance(size_t index) { return *instances[index]; }
+    size_t getInstanceCount() const { return instances.size(); }
+    size_t getThreadCount() const { return workers.size(); }
+
+    // Advance every instance by the given number of frames; blocks until done
+    void runFrames(uint32_t frames);
+
+    // Throughput of the last runFrames() call, summed over all instances
+    double getFramesPerSecond() const { return framesPerSecond; }
+
+private:
+    struct Job {
+        size_t instance;
+        uint32_t framesLeft;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::unique_ptr<ConsoleEmulator>> instances;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+    std::condition_variable jobQueued;
+    uint64_t generation;
+    bool stopping;
+    std::atomic<size_t> pendingInstances;
+    std::atomic<size_t> queuedJobs;     // Jobs in all deques
+    std::atomic<size_t> idleWorkers;    // Workers parked on jobQueued
+    double framesPerSecond;
+
+    void workerLoop(size_t index);
+    bool popJob(size_t index, Job& job);
+    bool stealJob(size_t index, Job& job);
+    void pushJob(size_t index, const Job& job);
+};
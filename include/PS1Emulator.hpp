@@ -1,19 +1,25 @@
 #pragma once
+#include "ConsoleCore.hpp"
 #include "PlayStationEmulator.hpp"
 
-class PS1Emulator : public PlayStationEmulator {
+class PS1Emulator : public ConsoleCore<PS1Emulator, PlayStationEmulator> {
+    friend class ConsoleCore<PS1Emulator, PlayStationEmulator>;
+
 public:
     PS1Emulator();
     ~PS1Emulator() override = default;
 
+    std::unique_ptr<ConsoleEmulator> fork() override;
+
 protected:
-    bool validateROM(const std::vector<uint8_t>& data) const override;
+    bool validateROM(const RomImage& data) const override;
 
 private:
     // PS1 specific memory map
     static constexpr uint32_t RAM_SIZE = 2 * 1024 * 1024;  // 2MB
     static constexpr uint32_t VRAM_SIZE = 1 * 1024 * 1024; // 1MB
     static constexpr uint32_t BIOS_SIZE = 512 * 1024;      // 512KB
+    static constexpr uint32_t CPU_CLOCK = 33868800;        // R3000A, 33.8688MHz
 
     // PS1 specific hardware
     struct {
@@ -30,8 +36,11 @@ private:
     static constexpr uint32_t SPU_STATUS_START = 0x1F801D88;
     static constexpr uint32_t SPU_RAM_SIZE = 512 * 1024;  // 512KB SPU RAM
 
-    void executeInstruction() override;
+    int runInstruction();
+    void executeInstruction();
     void handleSPUOperation();
     void handleCDROMOperation();
     void updateSPUStatus();
-}; 
+};
+
+extern template class ConsoleCore<PS1Emulator, PlayStationEmulator>;
@@ -1,19 +1,25 @@
 #pragma once
+#include "ConsoleCore.hpp"
 #include "PlayStationEmulator.hpp"
 
-class PS2Emulator : public PlayStationEmulator {
+class PS2Emulator : public ConsoleCore<PS2Emulator, PlayStationEmulator> {
+    friend class ConsoleCore<PS2Emulator, PlayStationEmulator>;
+
 public:
     PS2Emulator();
     ~PS2Emulator() override = default;
 
+    std::unique_ptr<ConsoleEmulator> fork() override;
+
 protected:
-    bool validateROM(const std::vector<uint8_t>& data) const override;
+    bool validateROM(const RomImage& data) const override;
 
 private:
     // PS2 specific memory map
     static constexpr uint32_t RAM_SIZE = 32 * 1024 * 1024;   // 32MB
     static constexpr uint32_t VRAM_SIZE = 4 * 1024 * 1024;   // 4MB
     static constexpr uint32_t BIOS_SIZE = 4 * 1024 * 1024;   // 4MB
+    static constexpr uint32_t CPU_CLOCK = 294912000;         // Emotion Engine, 294.912MHz
 
     // SPU2 memory map
     static constexpr uint32_t SPU2_START = 0x1F900000;
@@ -33,7 +39,7 @@ private:
     struct GraphicsSynthesizer {
         uint32_t status;
         uint32_t control;
-        std::vector<uint32_t> local_mem;  // GS local memory
+        CowMemory local_mem;  // GS local memory
     } gs;
 
     // I/O Processor
@@ -43,7 +49,8 @@ private:
         uint32_t hi, lo;     // Multiply/Divide results
     } iop;
 
-    void executeInstruction() override;
+    int runInstruction();
+    void executeInstruction();
     void executeEEInstruction();
     void executeIOPInstruction();
     void handleGSOperation();
@@ -53,4 +60,6 @@ private:
     // SPU2 helper functions
     void processSPU2Core(uint32_t coreBase);
     void mixSPU2Output();
-}; 
+};
+
+extern template class ConsoleCore<PS2Emulator, PlayStationEmulator>;
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized pixel conversion for the PPU.
+//
+// decode2bpp() turns Game Boy bitplane pairs (low byte, high byte, as they
+// sit in VRAM) into one color index per byte, eight pixels per pair: a tile
+// is 8 pairs, a 160-pixel line 20. applyPalette() maps color indices
+// through a BGP/OBP0/OBP1 style register. The best implementation for the
+// host CPU is picked on first use: AVX2 with BMI2 PDEP for leftover rows,
+// SSE2 on any x86-64, and otherwise the scalar reference, which is also
+// exposed for testing the vector paths against.
+struct PixelKernels {
+    static void decode2bpp(const uint8_t* planes, size_t pairs, uint8_t* out) {
+        kernels().decode(planes, pairs, out);
+    }
+    static void applyPalette(const uint8_t* indices, size_t count, uint8_t palette, uint8_t* out) {
+        kernels().palette(indices, count, palette, out);
+    }
+
+    // Reference implementations
+    static void decode2bppScalar(const uint8_t* planes, size_t pairs, uint8_t* out);
+    static void applyPaletteScalar(const uint8_t* indices, size_t count, uint8_t palette, uint8_t* out);
+
+    // "avx2", "sse2" or "scalar"
+    static const char* getPath() { return kernels().name; }
+
+    struct Table {
+        void (*decode)(const uint8_t* planes, size_t pairs, uint8_t* out);
+        void (*palette)(const uint8_t* indices, size_t count, uint8_t palette, uint8_t* out);
+        const char* name;
+    };
+
+private:
+    static const Table& kernels();
+};
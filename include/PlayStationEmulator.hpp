@@ -1,22 +1,24 @@
 #pragma once
 #include "ConsoleEmulator.hpp"
+#include "CowMemory.hpp"
+#include "SPU.hpp"
 #include <array>
 #include <memory>
 
+// Shared PlayStation state and memory map. PS1Emulator and PS2Emulator
+// derive through ConsoleCore, which supplies the ConsoleEmulator step,
+// batch and memory entry points on top of busRead()/busWrite() here and
+// their own runInstruction().
 class PlayStationEmulator : public ConsoleEmulator {
 public:
-    PlayStationEmulator(ConsoleType type, const std::string& name, uint32_t ramSize);
+    PlayStationEmulator(ConsoleType type, const std::string& name, uint32_t ramSize, uint32_t cpuClock);
     ~PlayStationEmulator() override = default;
 
     // Core emulation functions
     bool initialize() override;
-    void step() override;
     void reset() override;
-    bool loadROM(const std::vector<uint8_t>& data) override;
-
-    // Memory management
-    uint8_t readMemory(uint32_t address) const override;
-    void writeMemory(uint32_t address, uint8_t value) override;
+    using ConsoleEmulator::loadROM;
+    bool loadROM(std::shared_ptr<const RomImage> image) override;
 
     // State management
     bool saveState(const std::string& filepath) override;
@@ -31,14 +33,36 @@ public:
     uint32_t getRecommendedMemorySize() const override { return ramSize * 2; }
 
 protected:
-    bool validateROM(const std::vector<uint8_t>& data) const override;
-    bool detectConsoleType(const std::vector<uint8_t>& data) const override;
+    // Used by fork(); memory is shared copy-on-write, the SPU is copied
+    PlayStationEmulator(const PlayStationEmulator& other);
+
+    bool validateROM(const RomImage& data) const override;
+    bool detectConsoleType(const RomImage& data) const override;
+
+    // Memory bus; main RAM is the fast path
+    uint8_t busRead(uint32_t address) const {
+        return address < ram.size() ? ram.read(address) : readMemorySlow(address);
+    }
+    void busWrite(uint32_t address, uint8_t value) {
+        if (address < ram.size()) {
+            ram.write(address, value);
+        } else {
+            writeMemorySlow(address, value);
+        }
+    }
+    uint8_t readMemorySlow(uint32_t address) const;
+    void writeMemorySlow(uint32_t address, uint8_t value);
 
-    // Memory regions
-    std::vector<uint8_t> ram;        // Main RAM
-    std::vector<uint8_t> vram;       // Video RAM
-    std::vector<uint8_t> biosRom;    // BIOS ROM
-    std::vector<uint8_t> gameRom;    // Game data
+    void stepSPU();
+    uint64_t getCyclesPerFrame() const { return cyclesPerFrame; }
+
+    uint64_t cycleCount;
+
+    // Memory regions, shared copy-on-write between forks
+    CowMemory ram;        // Main RAM
+    CowMemory vram;       // Video RAM
+    CowMemory biosRom;    // BIOS ROM
+    std::shared_ptr<const RomImage> gameRom;  // Game data, mapped from the file
 
     // CPU state
     struct CPUState {
@@ -52,16 +76,19 @@ protected:
     struct GPUState {
         uint32_t status;
         uint32_t control;
-        std::vector<uint32_t> vram;
     } gpu;
 
+    std::unique_ptr<SPU> spu;
+    uint16_t spuWord;     // SPU registers are 16-bit; the low byte waits here for the high one
+
 private:
     ConsoleType consoleType;
     std::string consoleName;
     uint32_t ramSize;
+    uint32_t cyclesPerFrame;  // CPU clock / 60Hz
 
     void initializeMemory();
     void initializeCPU();
     void initializeGPU();
-    virtual void executeInstruction() = 0;
+    void initializeSPU();
 }; 
@@ -0,0 +1,84 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Execution profile of emulated code, per (ROM bank, PC).
+//
+// Addresses outside the switchable ROM window index one flat 64K array.
+// The window 4000-7FFF has a block of 16K entries per bank instead, so the
+// same PC in different banks is kept apart. A bank's block is allocated the
+// first time code runs from it, so profiling a large ROM only costs memory
+// for the banks it executes. Cartridge RAM banks are not told apart. Cycles the CPU spends halted or in skipped idle loops are
+// totalled separately.
+class Profiler {
+public:
+    struct Entry {
+        uint64_t count;
+        uint64_t cycles;
+    };
+
+    struct HotSpot {
+        uint16_t bank;
+        uint16_t address;
+        uint64_t count;
+        uint64_t cycles;
+    };
+
+    Profiler();
+
+    void record(uint16_t bank, uint16_t address, uint64_t count, uint64_t cycles) {
+        Entry& entry = at(bank, address);
+        entry.count += count;
+        entry.cycles += cycles;
+        totalCycles += cycles;
+    }
+
+    void recordHalt(uint64_t cycles) {
+        haltCycles += cycles;
+    }
+
+    void clear();
+
+    uint64_t getTotalCycles() const { return totalCycles; }
+    uint64_t getHaltCycles() const { return haltCycles; }
+
+    // Locations sorted by cycles spent, most expensive first
+    std::vector<HotSpot> getHotSpots(size_t limit) const;
+
+    // Text report of the top locations, one line each
+    std::string report(size_t limit, const std::function<std::string(const HotSpot&)>& disassemble) const;
+
+    // Cycles per address with all banks folded together
+    std::vector<uint64_t> getHeatmap() const;
+
+    // Heatmap as a 256x256 greyscale PGM, one pixel per address (row =
+    // high byte), log-scaled
+    bool writeHeatmap(const std::string& filepath) const;
+
+private:
+    static constexpr uint16_t WINDOW_START = 0x4000;
+    static constexpr uint16_t WINDOW_SIZE = 0x4000;
+    using Bank = std::array<Entry, WINDOW_SIZE>;
+
+    std::vector<Entry> entries;                 // By address; the window's slots stay unused
+    std::vector<std::unique_ptr<Bank>> banks;   // Null until the bank runs code
+    uint64_t totalCycles;
+    uint64_t haltCycles;
+
+    Entry& at(uint16_t bank, uint16_t address) {
+        if (address < WINDOW_START || address >= WINDOW_START + WINDOW_SIZE) {
+            return entries[address];
+        }
+        if (bank >= banks.size()) {
+            banks.resize(bank + 1);
+        }
+        if (!banks[bank]) {
+            banks[bank] = std::make_unique<Bank>();  // Zeroed
+        }
+        return (*banks[bank])[address - WINDOW_START];
+    }
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+#include "BlockCache.hpp"
+
+// x86-64 call-threaded backend for SM83 basic blocks.
+//
+// Each block from the BlockCache is translated into a run of native calls
+// to the same SM83 handlers the interpreter uses, with PC updates, cycle
+// accounting and the early-exit checks on breakBlock and the event
+// deadline done inline. Only plain
+// register loads (NOP, LD r,r', LD r,n) are emitted as native moves, so
+// the gain is the removed fetch and dispatch, not translated code. The
+// generated code embeds the addresses of one emulator's state, so every
+// GameBoyEmulator owns its own Recompiler.
+//
+// The generated code has no unwind info, so nothing it calls may throw:
+// handlers report debugger callback exceptions through DebugHooks, which
+// holds them until the block has returned.
+//
+// Only available on Linux x86-64; isSupported() reports false elsewhere
+// and the emulator keeps interpreting.
+class Recompiler {
+public:
+    static constexpr size_t CODE_CACHE_SIZE = 4 * 1024 * 1024;
+
+    // Addresses of the emulator state the generated code touches
+    struct Context {
+        void* cpu;                      // GameBoyEmulator passed to handlers
+        uint16_t* pc;
+        uint8_t* registers[8];          // B, C, D, E, H, L, (HL), A; (HL) unused
+        bool* breakBlock;
+        uint64_t* instructionCount;
+        uint64_t* cycleCount;           // Advanced after every instruction
+        const uint64_t* deadline;       // Block exits once cycleCount reaches it
+    };
+
+    static bool isSupported();
+
+    explicit Recompiler(const Context& context);
+    ~Recompiler();
+    Recompiler(const Recompiler&) = delete;
+    Recompiler& operator=(const Recompiler&) = delete;
+
+    // Translate a block; returns nullptr when the code cache is full
+    BlockCache::NativeCode compile(const BlockCache::Block& block);
+
+    // Discard all generated code
+    void reset();
+
+    size_t getCodeSize() const { return used; }
+
+private:
+    Context context;
+    uint8_t* code;
+    size_t used;
+    std::vector<uint8_t> buffer;
+
+    void emit(std::initializer_list<uint8_t> bytes);
+    void emit32(uint32_t value);
+    void emit64(uint64_t value);
+    void emitPointer(const void* pointer) { emit64(reinterpret_cast<uintptr_t>(pointer)); }
+    int8_t registerOffset(int index) const;
+    bool emitInline(const BlockCache::Instruction& instruction);
+};
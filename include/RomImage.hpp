@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Read-only ROM or disc image shared by every core that uses it.
+//
+// open() maps the file read-only instead of reading it, so nothing is
+// copied at startup, pages are faulted in as the game touches them, and
+// they come from the OS page cache shared with other processes running the
+// same file. Within a process, opening the same path again returns the
+// image that is already mapped. Platforms without mmap read the file into
+// memory instead.
+class RomImage {
+public:
+    // Returns nullptr if the file can't be opened
+    static std::shared_ptr<const RomImage> open(const std::string& filepath);
+
+    // Wrap data that is already in memory
+    static std::shared_ptr<const RomImage> fromBuffer(std::vector<uint8_t> data);
+
+    ~RomImage();
+    RomImage(const RomImage&) = delete;
+    RomImage& operator=(const RomImage&) = delete;
+
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+    const uint8_t* begin() const { return bytes; }
+    const uint8_t* end() const { return bytes + length; }
+    uint8_t operator[](size_t index) const { return bytes[index]; }
+
+private:
+    RomImage() = default;
+
+    const uint8_t* bytes = nullptr;
+    size_t length = 0;
+    bool mapped = false;            // bytes is an mmap of the file
+    std::vector<uint8_t> buffer;    // Owned copy when not mapped
+};
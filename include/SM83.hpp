@@ -0,0 +1,81 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+
+class GameBoyEmulator;
+
+// SM83 (GameBoy CPU) instruction dispatch tables.
+//
+// Every opcode maps to a handler that receives the already-fetched immediate
+// operand (n, nn or the CB sub-opcode) and returns the T-cycles it consumed.
+// The tables are generated at compile time from the opcode bit patterns in
+// SM83.cpp, so adding or fixing an instruction means fixing its pattern once.
+struct SM83 {
+    using Handler = int (*)(GameBoyEmulator& gb, uint16_t operand);
+
+    static const std::array<Handler, 256> opcodeTable;
+    static const std::array<Handler, 256> cbOpcodeTable;
+
+    // Instruction length in bytes, including the opcode itself
+    static constexpr uint8_t instructionLength(uint8_t opcode) {
+        const uint8_t x = opcode >> 6;
+        const uint8_t y = (opcode >> 3) & 7;
+        const uint8_t z = opcode & 7;
+        if (x == 0) {
+            switch (z) {
+                case 0: return y == 0 ? 1 : (y == 1 ? 3 : 2);  // NOP / LD (nn),SP / STOP, JR
+                case 1: return (y & 1) ? 1 : 3;                 // ADD HL,rr / LD rr,nn
+                case 6: return 2;                               // LD r,n
+                default: return 1;
+            }
+        }
+        if (x == 3) {
+            switch (z) {
+                case 0: return y < 4 ? 1 : 2;                   // RET cc / LDH, ADD SP, LD HL,SP+d
+                case 2: return (y < 4 || y == 5 || y == 7) ? 3 : 1;
+                case 3: return y == 0 ? 3 : (y == 1 ? 2 : 1);   // JP nn / CB prefix
+                case 4: return y < 4 ? 3 : 1;                   // CALL cc,nn
+                case 5: return y == 1 ? 3 : 1;                  // CALL nn
+                case 6: return 2;                               // ALU A,n
+                default: return 1;
+            }
+        }
+        return 1;
+    }
+
+    // Opcodes with no defined behaviour on the SM83
+    static constexpr bool isUnknownOpcode(uint8_t opcode) {
+        switch (opcode) {
+            case 0xD3: case 0xDB: case 0xDD:
+            case 0xE3: case 0xE4: case 0xEB: case 0xEC: case 0xED:
+            case 0xF4: case 0xFC: case 0xFD:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Instructions after which straight-line execution cannot continue:
+    // control flow, interrupt state changes and opcodes that stop the CPU
+    static constexpr bool endsBlock(uint8_t opcode) {
+        switch (opcode) {
+            case 0x10: case 0x76:                               // STOP, HALT
+            case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:  // JR
+            case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: case 0xE9:  // JP
+            case 0xC4: case 0xCC: case 0xCD: case 0xD4: case 0xDC:  // CALL
+            case 0xC0: case 0xC8: case 0xC9: case 0xD0: case 0xD8: case 0xD9:  // RET, RETI
+            case 0xC7: case 0xCF: case 0xD7: case 0xDF:
+            case 0xE7: case 0xEF: case 0xF7: case 0xFF:         // RST
+            case 0xF3: case 0xFB:                               // DI, EI
+                return true;
+            default:
+                return isUnknownOpcode(opcode);
+        }
+    }
+
+    // Text for one instruction at address; operand is as passed to handlers
+    static std::string disassemble(uint16_t address, uint8_t opcode, uint16_t operand);
+
+    struct Ops;  // Handler templates, defined in SM83.cpp
+};
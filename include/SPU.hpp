@@ -1,7 +1,9 @@
 #pragma once
+#include "CowMemory.hpp"
 #include <array>
 #include <vector>
 #include <cstdint>
+#include <string>
 
 // Sound Processing Unit for PlayStation systems
 class SPU {
@@ -47,7 +49,7 @@ private:
     static constexpr size_t SPU_RAM_SIZE = 512 * 1024;  // 512KB for PS1, more for PS2
 
     std::vector<Voice> voices;
-    std::vector<uint8_t> spuRam;
+    CowMemory spuRam;     // Shared copy-on-write when the console forks
     std::vector<int16_t> audioBuffer;
 
     uint16_t mainVolume;
@@ -0,0 +1,72 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CowMemory.hpp"
+
+// Battery-backed cartridge RAM persisted to a .sav file.
+//
+// The emulator marks 256-byte pages dirty as the game writes them and calls
+// commit() once a frame. At most once per FLUSH_INTERVAL, commit() copies
+// the dirty pages into a staging buffer and wakes a writer thread, which
+// writes just those pages to the file. A game rewriting its save every
+// frame thus costs one page copy per dirtied page and one write per
+// interval. The emulation thread never waits on the disk: if the writer
+// is busy with the staging buffer, commit() leaves the pages dirty and
+// tries again next frame.
+class SaveRam {
+public:
+    static constexpr size_t PAGE_SIZE = 0x100;
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{1000};
+
+    SaveRam() = default;
+    ~SaveRam();
+    SaveRam(const SaveRam&) = delete;
+    SaveRam& operator=(const SaveRam&) = delete;
+
+    // Fills ram from the file if it exists, creating it otherwise, and
+    // starts the writer. Returns false if the file can't be created.
+    bool open(const std::string& path, CowMemory& ram);
+
+    // Writes out everything still dirty and stops the writer
+    void close(const CowMemory& ram);
+
+    bool isOpen() const { return writer.joinable(); }
+
+    void markDirty(size_t offset) {
+        if (offset < dirty.size() * PAGE_SIZE) {
+            dirty[offset / PAGE_SIZE] = 1;
+            anyDirty = true;
+        }
+    }
+    void markAllDirty();
+    bool isDirty(size_t offset) const {
+        return offset < dirty.size() * PAGE_SIZE && dirty[offset / PAGE_SIZE];
+    }
+
+    // Hands dirty pages to the writer, subject to FLUSH_INTERVAL unless
+    // forced. Returns true if pages were taken, which makes them clean.
+    bool commit(const CowMemory& ram, bool force = false);
+
+private:
+    std::string path;
+    std::vector<uint8_t> dirty;     // Per page, owned by the emulation thread
+    bool anyDirty = false;
+    std::chrono::steady_clock::time_point lastCommit;
+
+    // Shared with the writer
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::vector<uint8_t> staged;
+    std::vector<uint8_t> stagedPages;
+    bool pending = false;
+    bool stopping = false;
+    std::thread writer;
+
+    void stage(const CowMemory& ram);
+    void run();
+};
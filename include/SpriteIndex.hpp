@@ -0,0 +1,35 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// Which OAM entries cover each visible line.
+//
+// Every line keeps a 40-bit mask of the sprites whose Y range includes it.
+// Only a write to an entry's Y byte, or a switch between 8x8 and 8x16
+// sprites, can move an entry between lines, so the bins are updated as OAM
+// is written rather than rescanned on every line. select() applies the
+// hardware's 10 sprites per line limit, which counts the first entries in
+// OAM order regardless of X.
+class SpriteIndex {
+public:
+    static constexpr int SPRITE_COUNT = 40;
+    static constexpr int LINE_COUNT = 144;
+
+    SpriteIndex();
+
+    // Entry's Y byte changed
+    void update(int sprite, const uint8_t* oam, bool tall);
+    // All of OAM, or the sprite height, changed
+    void rebuild(const uint8_t* oam, bool tall);
+
+    // Fills out with up to limit entries on line, in OAM order; returns
+    // how many
+    int select(int line, uint8_t* out, int limit) const;
+
+private:
+    std::array<uint64_t, LINE_COUNT> lines;
+    std::array<uint8_t, SPRITE_COUNT> top;      // First line covered, as OAM Y
+    bool tall;
+
+    void setLines(int sprite, bool present);
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// VRAM tile data decoded for the renderers.
+//
+// Each tile row is kept as eight color indices (0-3), leftmost pixel
+// first, so the renderers copy rows instead of reassembling every pixel
+// from its two bitplanes. A write to tile data only marks the tile; it is
+// decoded again the next time one of its rows is drawn, so tiles that are
+// rewritten several times per frame, or never drawn, cost one flag store
+// per write. Room is reserved for the second VRAM bank of the GBC.
+class TileCache {
+public:
+    static constexpr int TILES_PER_BANK = 384;  // 8000-97FF
+    static constexpr int BANKS = 2;
+    static constexpr uint16_t TILE_DATA_SIZE = TILES_PER_BANK * 16;
+
+    TileCache();
+
+    // offset is relative to 8000; writes to the tile maps are ignored
+    void markDirty(int bank, uint16_t offset) {
+        if (offset < TILE_DATA_SIZE) {
+            dirty[bank * TILES_PER_BANK + (offset >> 4)] = true;
+        }
+    }
+    void markAllDirty() { dirty.fill(true); }
+
+    // Row y of tile (0-383) in bank, decoded from that bank's VRAM if stale
+    const uint8_t* row(int bank, int tile, int y, const uint8_t* vram) {
+        int index = bank * TILES_PER_BANK + tile;
+        if (dirty[index]) {
+            decode(index, vram + tile * 16);
+        }
+        return rows[index][y].data();
+    }
+
+    // Tile number from a tile map entry, for either LCDC.4 addressing mode
+    static int tileIndex(uint8_t entry, bool unsignedMode) {
+        return unsignedMode ? entry : 256 + static_cast<int8_t>(entry);
+    }
+
+private:
+    std::array<std::array<std::array<uint8_t, 8>, 8>, BANKS * TILES_PER_BANK> rows;
+    std::array<bool, BANKS * TILES_PER_BANK> dirty;
+
+    void decode(int index, const uint8_t* data);
+};
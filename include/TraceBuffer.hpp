@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// One executed instruction, as seen just before it ran
+struct TraceRecord {
+    uint64_t cycle;
+    uint16_t pc;
+    uint16_t af, bc, de, hl, sp;
+    uint8_t opcode[3];
+    uint8_t length;
+};
+
+// Instruction trace kept as a fixed-size ring of binary records.
+//
+// Recording is a struct copy; nothing is formatted until a reader asks for
+// text. When a trace file is open, records are also collected into chunks
+// that are delta-encoded and appended to the file, so a long run can be
+// traced in full while the ring only holds the most recent records.
+//
+// Each chunk is independent: a record count, a byte count, then records
+// encoded against the previous one in the chunk. Every record starts with a
+// byte holding the instruction length (bits 6-7) and which of PC (when not
+// just after the previous instruction), AF, BC, DE, HL and SP changed
+// (bits 0-5), followed by the cycle delta as a varint, the changed PC, the
+// opcode bytes, and the changed registers.
+class TraceBuffer {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+    static constexpr size_t CHUNK_RECORDS = 4096;
+
+    explicit TraceBuffer(size_t capacity = DEFAULT_CAPACITY);
+    ~TraceBuffer();
+
+    TraceBuffer(const TraceBuffer&) = delete;
+    TraceBuffer& operator=(const TraceBuffer&) = delete;
+
+    void record(const TraceRecord& entry) {
+        ring[head] = entry;
+        head = (head + 1) & (ring.size() - 1);
+        if (count < ring.size()) {
+            count++;
+        }
+        if (file) {
+            pending.push_back(entry);
+            if (pending.size() == CHUNK_RECORDS) {
+                flushChunk();
+            }
+        }
+    }
+
+    void clear();
+
+    // Records currently in the ring, oldest first
+    size_t size() const { return count; }
+    const TraceRecord& operator[](size_t index) const {
+        return ring[(head - count + index) & (ring.size() - 1)];
+    }
+
+    // Streaming to disk. close() writes out the partial last chunk.
+    bool open(const std::string& filepath);
+    void close();
+    bool isStreaming() const { return file != nullptr; }
+
+    static std::string format(const TraceRecord& entry);
+
+    // Reads back a file written while streaming
+    static bool readFile(const std::string& filepath, std::vector<TraceRecord>& records);
+
+private:
+    std::vector<TraceRecord> ring;   // Size is a power of two
+    size_t head;
+    size_t count;
+
+    std::FILE* file;
+    std::vector<TraceRecord> pending;
+    std::vector<uint8_t> encoded;
+
+    void flushChunk();
+};
@@ -0,0 +1,67 @@
+#include "BlockCache.hpp"
+#include <algorithm>
+
+void BlockCache::clear() {
+    blocks.clear();
+    for (auto& keys : pageBlocks) {
+        keys.clear();
+    }
+    codePages.fill(false);
+    pendingPages.clear();
+}
+
+const BlockCache::Block* BlockCache::find(uint32_t key) {
+    if (!pendingPages.empty()) {
+        flushInvalidated();
+    }
+
+    auto it = blocks.find(key);
+    return it != blocks.end() ? &it->second : nullptr;
+}
+
+const BlockCache::Block* BlockCache::insert(uint32_t key, Block&& block) {
+    // A block may end with an instruction that straddles into the next page
+    uint8_t firstPage = block.startPC >> 8;
+    uint8_t lastPage = (block.endPC - 1) >> 8;
+    pageBlocks[firstPage].push_back(key);
+    codePages[firstPage] = true;
+    if (lastPage != firstPage) {
+        pageBlocks[lastPage].push_back(key);
+        codePages[lastPage] = true;
+    }
+
+    return &(blocks[key] = std::move(block));
+}
+
+void BlockCache::invalidatePage(uint8_t page) {
+    if (codePages[page]) {
+        codePages[page] = false;
+        pendingPages.push_back(page);
+    }
+}
+
+void BlockCache::flushInvalidated() {
+    for (uint8_t page : pendingPages) {
+        for (uint32_t key : pageBlocks[page]) {
+            auto it = blocks.find(key);
+            if (it == blocks.end()) {
+                continue;
+            }
+
+            // A straddling block is also listed on its other page
+            uint8_t firstPage = it->second.startPC >> 8;
+            uint8_t lastPage = (it->second.endPC - 1) >> 8;
+            uint8_t otherPage = firstPage == page ? lastPage : firstPage;
+            if (otherPage != page) {
+                std::vector<uint32_t>& keys = pageBlocks[otherPage];
+                keys.erase(std::remove(keys.begin(), keys.end(), key), keys.end());
+                if (keys.empty()) {
+                    codePages[otherPage] = false;
+                }
+            }
+            blocks.erase(it);
+        }
+        pageBlocks[page].clear();
+    }
+    pendingPages.clear();
+}
@@ -0,0 +1,331 @@
+#include "Cartridge.hpp"
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace {
+
+// Header byte 0x149
+size_t ramSizeFromHeader(uint8_t code) {
+    switch (code) {
+        case 0x01: return 0x800;
+        case 0x02: return 0x2000;
+        case 0x03: return 0x8000;
+        case 0x04: return 0x20000;
+        case 0x05: return 0x10000;
+        default: return 0;
+    }
+}
+
+constexpr uint64_t CYCLES_PER_SECOND = 4194304;
+
+// What a bank past the end of the ROM reads as
+const std::vector<uint8_t> OPEN_BUS_BANK(Cartridge::ROM_BANK_SIZE, 0xFF);
+
+} // namespace
+
+Cartridge::Cartridge() : romBanks(0), ram(0, 13), mapper(Mapper::NONE), battery(false), hasClock(false) {
+    reset();
+}
+
+bool Cartridge::load(std::shared_ptr<const RomImage> image) {
+    if (!image || image->size() < 0x150) {
+        return false;
+    }
+    const RomImage& data = *image;
+
+    uint8_t type = data[0x147];
+    hasClock = false;
+    switch (type) {
+        case 0x00: mapper = Mapper::NONE; battery = false; break;
+        case 0x08: mapper = Mapper::NONE; battery = false; break;
+        case 0x09: mapper = Mapper::NONE; battery = true; break;
+        case 0x01: case 0x02: mapper = Mapper::MBC1; battery = false; break;
+        case 0x03: mapper = Mapper::MBC1; battery = true; break;
+        case 0x05: mapper = Mapper::MBC2; battery = false; break;
+        case 0x06: mapper = Mapper::MBC2; battery = true; break;
+        case 0x0F: case 0x10: mapper = Mapper::MBC3; battery = true; hasClock = true; break;
+        case 0x11: case 0x12: mapper = Mapper::MBC3; battery = false; break;
+        case 0x13: mapper = Mapper::MBC3; battery = true; break;
+        case 0x19: case 0x1A: case 0x1C: case 0x1D: mapper = Mapper::MBC5; battery = false; break;
+        case 0x1B: case 0x1E: mapper = Mapper::MBC5; battery = true; break;
+        default: return false;
+    }
+
+    // Banks are mapped straight from the image. Only a partial last bank
+    // is copied, so that its window can be read to the end.
+    romBanks = (data.size() + ROM_BANK_SIZE - 1) / ROM_BANK_SIZE;
+    size_t tail = data.size() % ROM_BANK_SIZE;
+    if (tail) {
+        lastRomBank.assign(ROM_BANK_SIZE, 0xFF);
+        std::copy(data.end() - tail, data.end(), lastRomBank.begin());
+    } else {
+        lastRomBank.clear();
+    }
+
+    // MBC2 has 512 half-bytes built in, stored one per byte
+    ram.assign(mapper == Mapper::MBC2 ? 0x200 : ramSizeFromHeader(data[0x149]), 0xFF);
+
+    std::memset(clock, 0, sizeof(clock));
+    std::memset(latchedClock, 0, sizeof(latchedClock));
+    clockCycle = 0;
+    rom = std::move(image);
+    reset();
+    return true;
+}
+
+void Cartridge::reset() {
+    ramEnabled = mapper == Mapper::NONE;  // Plain ROM+RAM has no enable register
+    romBankRegister = 1;
+    upperBits = 0;
+    ramBank = 0;
+    bankingMode = false;
+    latchWrite = 0xFF;
+    updateBanks();
+}
+
+bool Cartridge::writeRegister(uint16_t address, uint8_t value) {
+    uint16_t previousBank0 = romBank0;
+    uint16_t previousBankN = romBankN;
+    uint8_t previousRamBank = ramBankMapped;
+    bool previousRamEnabled = ramEnabled;
+    uint8_t previousRamSelect = ramBank;
+
+    switch (mapper) {
+        case Mapper::NONE:
+            return false;
+
+        case Mapper::MBC1:
+            if (address < 0x2000) {
+                ramEnabled = (value & 0x0F) == 0x0A;
+            } else if (address < 0x4000) {
+                romBankRegister = value & 0x1F;
+            } else if (address < 0x6000) {
+                upperBits = value & 0x03;
+            } else {
+                bankingMode = value & 0x01;
+            }
+            break;
+
+        case Mapper::MBC2:
+            // Address bit 8 selects between RAM enable and ROM bank
+            if (address < 0x4000) {
+                if (address & 0x0100) {
+                    romBankRegister = value & 0x0F;
+                } else {
+                    ramEnabled = (value & 0x0F) == 0x0A;
+                }
+            }
+            break;
+
+        case Mapper::MBC3:
+            if (address < 0x2000) {
+                ramEnabled = (value & 0x0F) == 0x0A;
+            } else if (address < 0x4000) {
+                romBankRegister = value & 0x7F;
+            } else if (address < 0x6000) {
+                ramBank = value & 0x0F;
+            } else {
+                if (latchWrite == 0x00 && value == 0x01) {
+                    std::memcpy(latchedClock, clock, sizeof(clock));
+                }
+                latchWrite = value;
+            }
+            break;
+
+        case Mapper::MBC5:
+            if (address < 0x2000) {
+                ramEnabled = (value & 0x0F) == 0x0A;
+            } else if (address < 0x3000) {
+                romBankRegister = (romBankRegister & 0x100) | value;
+            } else if (address < 0x4000) {
+                romBankRegister = (romBankRegister & 0xFF) | ((value & 0x01) << 8);
+            } else if (address < 0x6000) {
+                ramBank = value & 0x0F;
+            }
+            break;
+    }
+
+    updateBanks();
+    return romBank0 != previousBank0 || romBankN != previousBankN ||
+           ramBankMapped != previousRamBank || ramEnabled != previousRamEnabled ||
+           ramBank != previousRamSelect;
+}
+
+void Cartridge::updateBanks() {
+    // Bank numbers wrap at the power of two covering the ROM, as on the
+    // board; romWindow() handles the banks between its end and that
+    size_t mask = 1;
+    while (mask + 1 < romBanks) {
+        mask = (mask << 1) | 1;
+    }
+    uint16_t bank = romBankRegister;
+    romBank0 = 0;
+    ramBankMapped = 0;
+
+    switch (mapper) {
+        case Mapper::NONE:
+            bank = 1;
+            break;
+        case Mapper::MBC1:
+            if (bank == 0) {
+                bank = 1;
+            }
+            bank |= upperBits << 5;
+            if (bankingMode) {
+                romBank0 = (upperBits << 5) & mask;
+                ramBankMapped = upperBits;
+            }
+            break;
+        case Mapper::MBC2:
+        case Mapper::MBC3:
+            if (bank == 0) {
+                bank = 1;
+            }
+            ramBankMapped = ramBank & 0x03;
+            break;
+        case Mapper::MBC5:
+            ramBankMapped = ramBank;
+            break;
+    }
+
+    romBankN = bank & mask;
+    size_t ramBanks = ram.size() / RAM_BANK_SIZE;
+    if (ramBanks) {
+        ramBankMapped %= ramBanks;
+    }
+}
+
+const uint8_t* Cartridge::romWindow(uint16_t bank) const {
+    if (bank >= romBanks) {
+        return OPEN_BUS_BANK.data();
+    }
+    if (bank == romBanks - 1 && !lastRomBank.empty()) {
+        return lastRomBank.data();
+    }
+    return rom->data() + bank * ROM_BANK_SIZE;
+}
+
+const uint8_t* Cartridge::ramWindow() const {
+    if (!ramEnabled || mapper == Mapper::MBC2 || ram.size() < RAM_BANK_SIZE) {
+        return nullptr;
+    }
+    if (mapper == Mapper::MBC3 && ramBank >= 0x08) {
+        return nullptr;  // Clock register selected
+    }
+    return ram.readPointer(ramBankMapped * RAM_BANK_SIZE);
+}
+
+uint8_t* Cartridge::ramWriteWindow() const {
+    return ramWindow() ? ram.writePointer(ramBankMapped * RAM_BANK_SIZE) : nullptr;
+}
+
+size_t Cartridge::ramOffset(uint16_t address) const {
+    if (ram.size() == 0 || (mapper == Mapper::MBC3 && ramBank >= 0x08)) {
+        return NO_RAM;
+    }
+    if (mapper == Mapper::MBC2) {
+        return address & 0x1FF;
+    }
+    return (ramBankMapped * RAM_BANK_SIZE + (address - 0xA000)) % ram.size();
+}
+
+uint8_t Cartridge::readRam(uint16_t address) const {
+    if (!ramEnabled) {
+        return 0xFF;
+    }
+    if (mapper == Mapper::MBC3 && ramBank >= 0x08) {
+        return ramBank <= 0x0C ? latchedClock[ramBank - 0x08] : 0xFF;
+    }
+    size_t offset = ramOffset(address);
+    if (offset == NO_RAM) {
+        return 0xFF;
+    }
+    return mapper == Mapper::MBC2 ? ram.read(offset) | 0xF0 : ram.read(offset);
+}
+
+void Cartridge::writeRam(uint16_t address, uint8_t value) {
+    if (!ramEnabled) {
+        return;
+    }
+    if (mapper == Mapper::MBC3 && ramBank >= 0x08) {
+        if (ramBank <= 0x0C) {
+            clock[ramBank - 0x08] = value;
+        }
+        return;
+    }
+    size_t offset = ramOffset(address);
+    if (offset == NO_RAM) {
+        return;
+    }
+    ram.write(offset, mapper == Mapper::MBC2 ? value & 0x0F : value);
+}
+
+void Cartridge::updateClock(uint64_t cycle) {
+    if (!hasClock || cycle < clockCycle) {
+        clockCycle = cycle;
+        return;
+    }
+    uint64_t seconds = (cycle - clockCycle) / CYCLES_PER_SECOND;
+    clockCycle += seconds * CYCLES_PER_SECOND;
+    // Bit 6 of the day high register halts the clock
+    if (seconds && !(clock[4] & 0x40)) {
+        tickClock(seconds);
+    }
+}
+
+void Cartridge::tickClock(uint64_t seconds) {
+    uint64_t days = (clock[4] & 0x01) << 8 | clock[3];
+    uint64_t total = clock[0] + clock[1] * 60ull + clock[2] * 3600ull + days * 86400ull + seconds;
+    clock[0] = total % 60;
+    clock[1] = (total / 60) % 60;
+    clock[2] = (total / 3600) % 24;
+    days = total / 86400;
+    clock[3] = days & 0xFF;
+    clock[4] = (clock[4] & 0xFE) | ((days >> 8) & 0x01);
+    if (days > 0x1FF) {
+        clock[4] |= 0x80;  // Day counter carry
+    }
+}
+
+std::string Cartridge::getMapperName() const {
+    switch (mapper) {
+        case Mapper::MBC1: return "MBC1";
+        case Mapper::MBC2: return "MBC2";
+        case Mapper::MBC3: return hasClock ? "MBC3+RTC" : "MBC3";
+        case Mapper::MBC5: return "MBC5";
+        default: return "ROM only";
+    }
+}
+
+void Cartridge::saveState(std::ostream& out) const {
+    std::vector<uint8_t> data(ram.size());
+    ram.copyTo(data.data());
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    out.write(reinterpret_cast<const char*>(&ramEnabled), sizeof(ramEnabled));
+    out.write(reinterpret_cast<const char*>(&romBankRegister), sizeof(romBankRegister));
+    out.write(reinterpret_cast<const char*>(&upperBits), sizeof(upperBits));
+    out.write(reinterpret_cast<const char*>(&ramBank), sizeof(ramBank));
+    out.write(reinterpret_cast<const char*>(&bankingMode), sizeof(bankingMode));
+    out.write(reinterpret_cast<const char*>(clock), sizeof(clock));
+    out.write(reinterpret_cast<const char*>(latchedClock), sizeof(latchedClock));
+    out.write(reinterpret_cast<const char*>(&latchWrite), sizeof(latchWrite));
+    out.write(reinterpret_cast<const char*>(&clockCycle), sizeof(clockCycle));
+}
+
+void Cartridge::loadState(std::istream& in) {
+    std::vector<uint8_t> data(ram.size());
+    in.read(reinterpret_cast<char*>(data.data()), data.size());
+    ram.copyFrom(data.data());
+    in.read(reinterpret_cast<char*>(&ramEnabled), sizeof(ramEnabled));
+    in.read(reinterpret_cast<char*>(&romBankRegister), sizeof(romBankRegister));
+    in.read(reinterpret_cast<char*>(&upperBits), sizeof(upperBits));
+    in.read(reinterpret_cast<char*>(&ramBank), sizeof(ramBank));
+    in.read(reinterpret_cast<char*>(&bankingMode), sizeof(bankingMode));
+    in.read(reinterpret_cast<char*>(clock), sizeof(clock));
+    in.read(reinterpret_cast<char*>(latchedClock), sizeof(latchedClock));
+    in.read(reinterpret_cast<char*>(&latchWrite), sizeof(latchWrite));
+    in.read(reinterpret_cast<char*>(&clockCycle), sizeof(clockCycle));
+    updateBanks();
+}
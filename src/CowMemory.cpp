@@ -0,0 +1,100 @@
+#include "CowMemory.hpp"
+#include <algorithm>
+#include <cstring>
+
+CowMemory::CowMemory(size_t size, unsigned pageShift)
+    : memorySize(0), pageShift(pageShift), pageMask((size_t(1) << pageShift) - 1) {
+    assign(size);
+}
+
+CowMemory::CowMemory(const CowMemory& other)
+    : memorySize(other.memorySize),
+      pageShift(other.pageShift),
+      pageMask(other.pageMask),
+      pages(other.pages),
+      writablePages(other.pages.size(), nullptr) {
+    std::fill(other.writablePages.begin(), other.writablePages.end(), nullptr);
+}
+
+CowMemory& CowMemory::operator=(const CowMemory& other) {
+    if (this != &other) {
+        memorySize = other.memorySize;
+        pageShift = other.pageShift;
+        pageMask = other.pageMask;
+        pages = other.pages;
+        writablePages.assign(pages.size(), nullptr);
+        std::fill(other.writablePages.begin(), other.writablePages.end(), nullptr);
+    }
+    return *this;
+}
+
+void CowMemory::assign(size_t size, uint8_t value) {
+    memorySize = size;
+    size_t count = (size + pageMask) >> pageShift;
+    pages.resize(count);
+    writablePages.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        pages[i] = allocatePage(value);
+        writablePages[i] = pages[i].get();
+    }
+}
+
+void CowMemory::assign(const uint8_t* data, size_t size) {
+    assign(size);
+    copyFrom(data);
+}
+
+void CowMemory::fill(uint8_t value) {
+    for (size_t i = 0; i < pages.size(); i++) {
+        if (writablePages[i]) {
+            std::memset(writablePages[i], value, pageSize());
+        } else {
+            pages[i] = allocatePage(value);
+            writablePages[i] = pages[i].get();
+        }
+    }
+}
+
+uint8_t* CowMemory::makeWritable(size_t address) {
+    size_t index = address >> pageShift;
+    if (!writablePages[index]) {
+        // The other copies may have released the page since it was shared
+        if (pages[index].use_count() > 1) {
+            Page copy = allocatePage(0);
+            std::memcpy(copy.get(), pages[index].get(), pageSize());
+            pages[index] = std::move(copy);
+        }
+        writablePages[index] = pages[index].get();
+    }
+    return writablePages[index];
+}
+
+void CowMemory::writeShared(size_t address, uint8_t value) {
+    makeWritable(address)[address & pageMask] = value;
+}
+
+void CowMemory::copyTo(uint8_t* data) const {
+    for (size_t i = 0; i < pages.size(); i++) {
+        size_t offset = i << pageShift;
+        std::memcpy(data + offset, pages[i].get(), std::min(pageSize(), memorySize - offset));
+    }
+}
+
+void CowMemory::copyFrom(const uint8_t* data) {
+    for (size_t i = 0; i < pages.size(); i++) {
+        size_t offset = i << pageShift;
+        std::memcpy(makeWritable(offset), data + offset, std::min(pageSize(), memorySize - offset));
+    }
+}
+
+size_t CowMemory::sharedPageCount() const {
+    return std::count_if(pages.begin(), pages.end(), [](const Page& page) {
+        return page.use_count() > 1;
+    });
+}
+
+CowMemory::Page CowMemory::allocatePage(uint8_t value) const {
+    Page page(new uint8_t[pageSize()]);
+    std::memset(page.get(), value, pageSize());
+    return page;
+}
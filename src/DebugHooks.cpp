@@ -0,0 +1,85 @@
+#include "DebugHooks.hpp"
+
+DebugHooks::DebugHooks() : hookCount(0), armed(false), stopFlag(nullptr) {
+    clearAll();
+}
+
+void DebugHooks::set(Access access, uint16_t address, Callback callback) {
+    if (!isSet(access, address)) {
+        bits[access][address >> 6] |= uint64_t(1) << (address & 63);
+        pageCounts[access][address >> 8]++;
+        hookCount++;
+    }
+    if (callback) {
+        callbacks[access][address] = std::move(callback);
+    } else {
+        callbacks[access].erase(address);
+    }
+    armed = true;
+}
+
+void DebugHooks::clear(Access access, uint16_t address) {
+    if (!isSet(access, address)) {
+        return;
+    }
+    bits[access][address >> 6] &= ~(uint64_t(1) << (address & 63));
+    pageCounts[access][address >> 8]--;
+    callbacks[access].erase(address);
+    hookCount--;
+    armed = hookCount != 0;
+}
+
+void DebugHooks::clearAll(Access access) {
+    for (uint32_t page = 0; page < 256; page++) {
+        hookCount -= pageCounts[access][page];
+    }
+    bits[access].fill(0);
+    pageCounts[access].fill(0);
+    callbacks[access].clear();
+    armed = hookCount != 0;
+}
+
+void DebugHooks::clearAll() {
+    for (int access = 0; access < ACCESS_KINDS; access++) {
+        bits[access].fill(0);
+        pageCounts[access].fill(0);
+        callbacks[access].clear();
+    }
+    hookCount = 0;
+    armed = false;
+}
+
+bool DebugHooks::anySet(Access access, uint16_t start, uint32_t end) const {
+    for (uint32_t address = start; address < end && address <= 0xFFFF; address++) {
+        if (!pageCounts[access][address >> 8]) {
+            address |= 0xFF;  // Skip the rest of an unhooked page
+        } else if (isSet(access, static_cast<uint16_t>(address))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DebugHooks::notify(Access access, uint16_t address, uint8_t value) const noexcept {
+    try {
+        auto it = callbacks[access].find(address);
+        if (it != callbacks[access].end()) {
+            it->second(address, value);
+        } else if (defaultHandler) {
+            defaultHandler(address, value);
+        }
+    } catch (...) {
+        if (!pending) {
+            pending = std::current_exception();
+        }
+        if (stopFlag) {
+            *stopFlag = true;
+        }
+    }
+}
+
+void DebugHooks::throwPending() const {
+    std::exception_ptr exception = pending;
+    pending = nullptr;
+    std::rethrow_exception(exception);
+}
@@ -24,31 +24,32 @@ std::string Emulator::getConsoleName() const {
 }
 
 bool Emulator::loadFile(const std::string& filepath) {
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file) {
+    // Map the file rather than reading it; pages load on first access and
+    // are shared with any other instance running the same file
+    fileData = RomImage::open(filepath);
+    if (!fileData) {
         std::cerr << "Failed to open file: " << filepath << std::endl;
         return false;
     }
 
-    // Read the entire file into fileData
-    fileData.clear();
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
-    
-    fileData.resize(fileSize);
-    file.read(reinterpret_cast<char*>(fileData.data()), fileSize);
-
     // Auto-detect console type if not set
     if (!console) {
-        ConsoleType detectedType = detectConsoleType(fileData);
+        ConsoleType detectedType = detectConsoleType(*fileData);
         if (!setConsoleType(detectedType)) {
             std::cerr << "Failed to create emulator for detected console type" << std::endl;
             return false;
         }
     }
 
-    return console->loadROM(fileData);
+    if (!console->loadROM(fileData)) {
+        return false;
+    }
+
+    // Battery-backed Game Boy carts keep their RAM next to the ROM
+    if (auto* gameBoy = dynamic_cast<GameBoyEmulator*>(console.get())) {
+        gameBoy->setSaveFile(GameBoyEmulator::defaultSaveFile(filepath));
+    }
+    return true;
 }
 
 void Emulator::writeMemory(uint32_t address, uint8_t value) {
@@ -79,13 +80,20 @@ void Emulator::step() {
 
 void Emulator::run() {
     if (console) {
+        // The stop flag is only checked between frames
         isRunning = true;
         while (isRunning) {
-            step();
+            console->runUntilVBlank();
         }
     }
 }
 
+void Emulator::runFrames(uint32_t frames) {
+    if (console) {
+        console->runFrames(frames);
+    }
+}
+
 void Emulator::stop() {
     isRunning = false;
 }
@@ -109,7 +117,7 @@ void Emulator::loadState(const std::string& filepath) {
     }
 }
 
-ConsoleType Emulator::detectConsoleType(const std::vector<uint8_t>& data) const {
+ConsoleType Emulator::detectConsoleType(const RomImage& data) const {
     // TODO: Implement ROM header detection for different console types
     // This is a placeholder implementation
     if (data.size() < 4) return ConsoleType::UNKNOWN;
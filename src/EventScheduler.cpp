@@ -0,0 +1,121 @@
+#include "EventScheduler.hpp"
+#include <istream>
+#include <ostream>
+
+EventScheduler::EventScheduler() {
+    reset();
+}
+
+void EventScheduler::reset() {
+    count = 0;
+    position.fill(-1);
+}
+
+void EventScheduler::schedule(int id, uint64_t timestamp) {
+    int slot = position[id];
+    if (slot < 0) {
+        slot = count++;
+        place(slot, {timestamp, id});
+        siftUp(slot);
+        return;
+    }
+
+    uint64_t previous = heap[slot].timestamp;
+    heap[slot].timestamp = timestamp;
+    if (timestamp < previous) {
+        siftUp(slot);
+    } else {
+        siftDown(slot);
+    }
+}
+
+void EventScheduler::cancel(int id) {
+    int slot = position[id];
+    if (slot >= 0) {
+        removeAt(slot);
+    }
+}
+
+uint64_t EventScheduler::getTimestamp(int id) const {
+    int slot = position[id];
+    return slot >= 0 ? heap[slot].timestamp : NEVER;
+}
+
+int EventScheduler::popEvent(uint64_t& timestamp) {
+    if (count == 0) {
+        return -1;
+    }
+
+    int id = heap[0].id;
+    timestamp = heap[0].timestamp;
+    removeAt(0);
+    return id;
+}
+
+void EventScheduler::saveState(std::ostream& out) const {
+    for (int id = 0; id < MAX_EVENTS; id++) {
+        uint64_t timestamp = getTimestamp(id);
+        out.write(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+    }
+}
+
+void EventScheduler::loadState(std::istream& in) {
+    reset();
+    for (int id = 0; id < MAX_EVENTS; id++) {
+        uint64_t timestamp = NEVER;
+        in.read(reinterpret_cast<char*>(&timestamp), sizeof(timestamp));
+        if (in && timestamp != NEVER) {
+            schedule(id, timestamp);
+        }
+    }
+}
+
+void EventScheduler::place(int slot, const Entry& entry) {
+    heap[slot] = entry;
+    position[entry.id] = slot;
+}
+
+void EventScheduler::removeAt(int slot) {
+    position[heap[slot].id] = -1;
+    count--;
+    if (slot == count) {
+        return;
+    }
+
+    Entry moved = heap[count];
+    place(slot, moved);
+    siftUp(slot);
+    siftDown(position[moved.id]);
+}
+
+void EventScheduler::siftUp(int slot) {
+    Entry entry = heap[slot];
+    while (slot > 0) {
+        int parent = (slot - 1) / 2;
+        if (heap[parent].timestamp <= entry.timestamp) {
+            break;
+        }
+        place(slot, heap[parent]);
+        slot = parent;
+    }
+    place(slot, entry);
+}
+
+void EventScheduler::siftDown(int slot) {
+    Entry entry = heap[slot];
+    while (true) {
+        int child = slot * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && heap[child + 1].timestamp < heap[child].timestamp) {
+            child++;
+        }
+        if (entry.timestamp <= heap[child].timestamp) {
+            break;
+        }
+        place(slot, heap[child]);
+        slot = child;
+    }
+    place(slot, entry);
+}
@@ -2,56 +2,290 @@
 #include <fstream>
 #include <iostream>
 #include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include "SM83.hpp"
+#include "PixelKernels.hpp"
 
-GameBoyEmulator::GameBoyEmulator() {
+GameBoyEmulator::GameBoyEmulator()
+    : executionMode(ExecutionMode::INTERPRETER),
+      vram(VRAM_SIZE, 13),
+      wramBank0(RAM_BANK_SIZE, 12),
+      wramBankN(0, 12),
+      frameBuffer(SCREEN_WIDTH * SCREEN_HEIGHT, 0),
+      frameSkip(1),
+      frameSkipRequiresCallback(false) {
+    traceLogging = false;
+    profiling = false;
+    debugHooks.setStopFlag(&breakBlock);
     reset();
 }
 
+GameBoyEmulator::~GameBoyEmulator() {
+    saveRam.close(cartridge.getRam());
+}
+
 bool GameBoyEmulator::initialize() {
     reset();
     return true;
 }
 
 void GameBoyEmulator::step() {
-    executeInstruction();
+    cycleCount += runInstruction();
+    debugHooks.rethrowPending();
+    if (cycleCount >= scheduler.nextEventTime()) {
+        processEvents();
+    }
+}
+
+uint64_t GameBoyEmulator::runCycles(uint64_t cycles) {
+    uint64_t start = cycleCount;
+    runUntil(start + cycles);
+    // Battery RAM is otherwise committed at VBlank, which needs the LCD on
+    if (!ppuEnabled) {
+        commitSaveRam(false);
+    }
+    return cycleCount - start;
+}
+
+uint64_t GameBoyEmulator::runUntilVBlank() {
+    // With the LCD off there is no VBlank; stop after a frame's worth
+    uint64_t start = cycleCount;
+    uint64_t frame = frameCount;
+    uint64_t limit = start + FRAME_CYCLES;
+    while (frameCount == frame && cycleCount < limit) {
+        runUntil(std::min(limit, scheduler.nextEventTime()));
+    }
+    if (!ppuEnabled) {
+        commitSaveRam(false);
+    }
+    return cycleCount - start;
+}
+
+// Runs one instruction, or one whole block in block cache mode, and
+// returns the cycles taken that cycleCount doesn't include yet. Blocks
+// advance cycleCount themselves and return 0.
+int GameBoyEmulator::runInstruction() {
+    int cycles = handleInterrupts();
+    if (cycles == 0) {
+        bool enableInterrupts = interrupts.enablePending;
+        if (halted) {
+            cycles = 4;
+            if (profiling) {
+                profiler.recordHalt(cycles);
+            }
+        } else if (executionMode != ExecutionMode::INTERPRETER && !enableInterrupts &&
+                   !debugStepping && !traceLogging && !profiling) {
+            // EI ends a block, so the instruction it delays IME for is
+            // always stepped on its own below. Single-stepping and tracing
+            // also need the interpreter's per-instruction view; breakpoints
+            // only for the blocks that contain one.
+            return executeBlock();
+        } else if (profiling) {
+            cycles = executeProfiled();
+        } else {
+            cycles = executeInstruction();
+        }
+        if (enableInterrupts && interrupts.enablePending) {
+            interrupts.master = true;
+            interrupts.enablePending = false;
+        }
+    }
+    instructionCount++;
+    return cycles;
+}
+
+void GameBoyEmulator::runUntil(uint64_t targetCycle) {
+    while (cycleCount < targetCycle) {
+        // Run the CPU freely up to the next hardware event. I/O writes may
+        // schedule an earlier event, so the deadline is re-read each time.
+        while (cycleCount < targetCycle && cycleCount < scheduler.nextEventTime()) {
+            if (!skipIdle(std::min(targetCycle, scheduler.nextEventTime()))) {
+                cycleCount += runInstruction();
+                // Debugger callbacks' exceptions surface once the instruction is done
+                debugHooks.rethrowPending();
+            }
+        }
+        processEvents();
+    }
+}
+
+// Fast-forward through HALT and LY/STAT polling loops up to deadline.
+//
+// Nothing the CPU can observe changes before the next scheduled event, so
+// the skipped instructions are accounted for in bulk. Cycle and instruction
+// counts end up exactly as if each instruction had been run.
+bool GameBoyEmulator::skipIdle(uint64_t deadline) {
+    if (halted) {
+        // A pending interrupt wakes the CPU on the next instruction
+        if (interrupts.flags & interrupts.enable & 0x1F) {
+            return false;
+        }
+        uint64_t steps = (deadline - cycleCount + 3) / 4;
+        cycleCount += steps * 4;
+        instructionCount += steps;
+        if (profiling) {
+            profiler.recordHalt(steps * 4);
+        }
+        return true;
+    }
+
+    // Traces show every instruction the CPU runs, and breakpoints and
+    // watchpoints must see every iteration
+    if (interrupts.enablePending || traceLogging || debugHooks.isArmed()) {
+        return false;
+    }
+
+    // An interrupt raised since the last event is taken on the next
+    // instruction, not at the next event
+    if (interrupts.master && (interrupts.flags & interrupts.enable & 0x1F)) {
+        return false;
+    }
+
+    // LDH A,(n) or LD A,(FF00+n); then CP n or AND n; then JR NZ/JR Z back
+    uint16_t pc = registers.pc;
+    uint8_t opcode = busRead(pc);
+    uint8_t ioAddress;
+    uint8_t loadLength;
+    int loadCycles;
+    if (opcode == 0xF0) {
+        ioAddress = busRead(pc + 1);
+        loadLength = 2;
+        loadCycles = 12;
+    } else if (opcode == 0xFA && busRead(pc + 2) == 0xFF) {
+        ioAddress = busRead(pc + 1);
+        loadLength = 3;
+        loadCycles = 16;
+    } else {
+        return false;
+    }
+
+    // Only registers that change solely on PPU events
+    if (ioAddress != 0x41 && ioAddress != 0x44) {
+        return false;
+    }
+
+    uint16_t aluPC = pc + loadLength;
+    uint8_t aluOpcode = busRead(aluPC);
+    uint8_t jumpOpcode = busRead(aluPC + 2);
+    int8_t jumpOffset = static_cast<int8_t>(busRead(aluPC + 3));
+    if ((aluOpcode != 0xFE && aluOpcode != 0xE6) ||
+        (jumpOpcode != 0x20 && jumpOpcode != 0x28) ||
+        jumpOffset != -(loadLength + 4)) {
+        return false;
+    }
+
+    // Would the loop go round again?
+    uint8_t value = readIO(ioAddress);
+    uint8_t operand = busRead(aluPC + 1);
+    bool zero = aluOpcode == 0xFE ? value == operand : (value & operand) == 0;
+    if (zero != (jumpOpcode == 0x28)) {
+        return false;
+    }
+
+    // LD + CP/AND (8) + taken JR (12)
+    int loopCycles = loadCycles + 8 + 12;
+    uint64_t iterations = (deadline - cycleCount) / loopCycles;
+    if (iterations == 0) {
+        return false;
+    }
+
+    cycleCount += iterations * loopCycles;
+    instructionCount += iterations * 3;
+    if (profiling) {
+        uint16_t bank = getBankForAddress(pc);
+        profiler.record(bank, pc, iterations, iterations * loadCycles);
+        profiler.record(bank, aluPC, iterations, iterations * 8);
+        profiler.record(bank, aluPC + 2, iterations, iterations * 12);
+    }
+    registers.a = value;
+    if (aluOpcode == 0xFE) {
+        cp8(operand);
+    } else {
+        and8(operand);
+    }
+    return true;
+}
+
+void GameBoyEmulator::processEvents() {
+    while (scheduler.nextEventTime() <= cycleCount) {
+        uint64_t timestamp;
+        switch (scheduler.popEvent(timestamp)) {
+            case EVENT_PPU_MODE:
+                onPPUModeEvent(timestamp);
+                break;
+            case EVENT_TIMER_OVERFLOW:
+                onTimerOverflow(timestamp);
+                break;
+            case EVENT_DMA_COMPLETE:
+                onDMAComplete();
+                break;
+        }
+    }
 }
 
 void GameBoyEmulator::reset() {
-    std::fill(memory.begin(), memory.end(), 0);
+    vram.fill(0);
+    tileCache.markAllDirty();
+    wramBank0.fill(0);
+    wramBankN.assign(0x1000, 0);  // DMG: WRAM bank 1 at D000
+    oam.fill(0);
+    hram.fill(0);
     initializeRegisters();
+    initializeHardware();
 }
 
-bool GameBoyEmulator::loadROM(const std::vector<uint8_t>& data) {
-    if (!validateROM(data)) {
+bool GameBoyEmulator::loadROM(std::shared_ptr<const RomImage> image) {
+    if (!image || !validateROM(*image)) {
         return false;
     }
 
-    cartridgeROM = data;
-    // Copy ROM to memory (first 32KB)
-    size_t romSize = std::min(data.size(), static_cast<size_t>(0x8000));
-    std::copy(data.begin(), data.begin() + romSize, memory.begin());
+    // The old cartridge's RAM goes to its own save file
+    saveRam.close(cartridge.getRam());
+    savePath.clear();
+
+    if (!cartridge.load(image)) {
+        return false;
+    }
+    batteryBacked = cartridge.hasBattery();
+    disassembler.clear();
+    blockCache.clear();
+    if (recompiler) {
+        recompiler->reset();
+    }
+    updateMemoryMap();
     return true;
 }
 
 uint8_t GameBoyEmulator::readMemory(uint32_t address) const {
-    if (address >= memory.size()) {
+    if (address > 0xFFFF) {
         throw std::out_of_range("Memory address out of bounds");
     }
-    return memory[address];
+    uint8_t value = busRead(static_cast<uint16_t>(address));
+    debugHooks.rethrowPending();
+    return value;
 }
 
 void GameBoyEmulator::writeMemory(uint32_t address, uint8_t value) {
-    if (address >= memory.size()) {
+    if (address > 0xFFFF) {
         throw std::out_of_range("Memory address out of bounds");
     }
-    
-    // Handle memory regions
-    if (address < 0x8000) {
-        // ROM area - ignore writes
-        return;
-    }
-    
-    memory[address] = value;
+    busWrite(static_cast<uint16_t>(address), value);
+    debugHooks.rethrowPending();
+}
+
+// Copy-on-write memory goes through a flat buffer in save states
+static void saveMemory(std::ostream& out, const CowMemory& memory) {
+    std::vector<uint8_t> data(memory.size());
+    memory.copyTo(data.data());
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+static void loadMemory(std::istream& in, CowMemory& memory) {
+    std::vector<uint8_t> data(memory.size());
+    in.read(reinterpret_cast<char*>(data.data()), data.size());
+    memory.copyFrom(data.data());
 }
 
 bool GameBoyEmulator::saveState(const std::string& filepath) {
@@ -61,13 +295,42 @@ bool GameBoyEmulator::saveState(const std::string& filepath) {
     }
 
     // Save memory
-    file.write(reinterpret_cast<const char*>(memory.data()), memory.size());
+    saveMemory(file, vram);
+    saveMemory(file, wramBank0);
+    saveMemory(file, wramBankN);
+    file.write(reinterpret_cast<const char*>(oam.data()), oam.size());
+    file.write(reinterpret_cast<const char*>(hram.data()), hram.size());
+    cartridge.saveState(file);
     
-    // Save registers
+    // Save registers (with the lazily evaluated flags folded back into F)
+    registers.f = getFlags();
     file.write(reinterpret_cast<const char*>(&registers), sizeof(registers));
-    file.write(reinterpret_cast<const char*>(&gpu), sizeof(gpu));
-    
-    return true;
+    file.write(reinterpret_cast<const char*>(&halted), sizeof(halted));
+    file.write(reinterpret_cast<const char*>(&stopped), sizeof(stopped));
+    file.write(reinterpret_cast<const char*>(&interrupts), sizeof(interrupts));
+
+    // Save hardware state. Event timestamps are absolute, so the cycle
+    // counter goes with them.
+    file.write(reinterpret_cast<const char*>(io.data()), io.size());
+    file.write(reinterpret_cast<const char*>(&graphics), sizeof(graphics));
+    file.write(reinterpret_cast<const char*>(&ppuMode), sizeof(ppuMode));
+    file.write(reinterpret_cast<const char*>(&ppuEnabled), sizeof(ppuEnabled));
+    file.write(reinterpret_cast<const char*>(&ppuWindowEnabled), sizeof(ppuWindowEnabled));
+    file.write(reinterpret_cast<const char*>(&ppuBackgroundEnabled), sizeof(ppuBackgroundEnabled));
+    file.write(reinterpret_cast<const char*>(&ppuSpritesEnabled), sizeof(ppuSpritesEnabled));
+    file.write(reinterpret_cast<const char*>(&ppuTallSprites), sizeof(ppuTallSprites));
+    file.write(reinterpret_cast<const char*>(&windowLine), sizeof(windowLine));
+    file.write(reinterpret_cast<const char*>(&dma), sizeof(dma));
+    file.write(reinterpret_cast<const char*>(&timerCounter), sizeof(timerCounter));
+    file.write(reinterpret_cast<const char*>(&timerModulo), sizeof(timerModulo));
+    file.write(reinterpret_cast<const char*>(&timerEnabled), sizeof(timerEnabled));
+    file.write(reinterpret_cast<const char*>(&timerClock), sizeof(timerClock));
+    file.write(reinterpret_cast<const char*>(&dividerBase), sizeof(dividerBase));
+    file.write(reinterpret_cast<const char*>(&timerSyncCycle), sizeof(timerSyncCycle));
+    file.write(reinterpret_cast<const char*>(&cycleCount), sizeof(cycleCount));
+    scheduler.saveState(file);
+
+    return static_cast<bool>(file);
 }
 
 bool GameBoyEmulator::loadState(const std::string& filepath) {
@@ -77,16 +340,140 @@ bool GameBoyEmulator::loadState(const std::string& filepath) {
     }
 
     // Load memory
-    file.read(reinterpret_cast<char*>(memory.data()), memory.size());
-    
+    loadMemory(file, vram);
+    tileCache.markAllDirty();
+    loadMemory(file, wramBank0);
+    loadMemory(file, wramBankN);
+    file.read(reinterpret_cast<char*>(oam.data()), oam.size());
+    file.read(reinterpret_cast<char*>(hram.data()), hram.size());
+    cartridge.loadState(file);
+    saveRam.markAllDirty();
+
     // Load registers
     file.read(reinterpret_cast<char*>(&registers), sizeof(registers));
-    file.read(reinterpret_cast<char*>(&gpu), sizeof(gpu));
-    
-    return true;
+    setFlags(registers.f);
+    file.read(reinterpret_cast<char*>(&halted), sizeof(halted));
+    file.read(reinterpret_cast<char*>(&stopped), sizeof(stopped));
+    file.read(reinterpret_cast<char*>(&interrupts), sizeof(interrupts));
+
+    // Load hardware state; the loaded events replace the queued ones
+    file.read(reinterpret_cast<char*>(io.data()), io.size());
+    file.read(reinterpret_cast<char*>(&graphics), sizeof(graphics));
+    file.read(reinterpret_cast<char*>(&ppuMode), sizeof(ppuMode));
+    file.read(reinterpret_cast<char*>(&ppuEnabled), sizeof(ppuEnabled));
+    file.read(reinterpret_cast<char*>(&ppuWindowEnabled), sizeof(ppuWindowEnabled));
+    file.read(reinterpret_cast<char*>(&ppuBackgroundEnabled), sizeof(ppuBackgroundEnabled));
+    file.read(reinterpret_cast<char*>(&ppuSpritesEnabled), sizeof(ppuSpritesEnabled));
+    file.read(reinterpret_cast<char*>(&ppuTallSprites), sizeof(ppuTallSprites));
+    file.read(reinterpret_cast<char*>(&windowLine), sizeof(windowLine));
+    file.read(reinterpret_cast<char*>(&dma), sizeof(dma));
+    file.read(reinterpret_cast<char*>(&timerCounter), sizeof(timerCounter));
+    file.read(reinterpret_cast<char*>(&timerModulo), sizeof(timerModulo));
+    file.read(reinterpret_cast<char*>(&timerEnabled), sizeof(timerEnabled));
+    file.read(reinterpret_cast<char*>(&timerClock), sizeof(timerClock));
+    file.read(reinterpret_cast<char*>(&dividerBase), sizeof(dividerBase));
+    file.read(reinterpret_cast<char*>(&timerSyncCycle), sizeof(timerSyncCycle));
+    file.read(reinterpret_cast<char*>(&cycleCount), sizeof(cycleCount));
+    scheduler.loadState(file);
+
+    spriteIndex.rebuild(oam.data(), ppuTallSprites);
+    blockCache.clear();
+    if (recompiler) {
+        recompiler->reset();
+    }
+    updateMemoryMap();
+
+    return static_cast<bool>(file);
+}
+
+GameBoyEmulator::GameBoyEmulator(const GameBoyEmulator& other)
+    : ConsoleEmulator(other),
+      registers(other.registers),
+      lazyFlags(other.lazyFlags),
+      halted(other.halted),
+      stopped(other.stopped),
+      unknownOpcodeCount(other.unknownOpcodeCount),
+      executionMode(ExecutionMode::INTERPRETER),
+      breakBlock(false),
+      blockDeadline(0),
+      cartridge(other.cartridge),
+      vram(other.vram),
+      wramBank0(other.wramBank0),
+      wramBankN(other.wramBankN),
+      oam(other.oam),
+      io(other.io),
+      hram(other.hram),
+      batteryBacked(other.batteryBacked),
+      romPath(other.romPath),
+      ppuMode(other.ppuMode),
+      ppuModeClock(other.ppuModeClock),
+      ppuLine(other.ppuLine),
+      ppuScrollX(other.ppuScrollX),
+      ppuScrollY(other.ppuScrollY),
+      ppuWindowX(other.ppuWindowX),
+      ppuWindowY(other.ppuWindowY),
+      ppuWindowEnabled(other.ppuWindowEnabled),
+      ppuEnabled(other.ppuEnabled),
+      ppuBackgroundEnabled(other.ppuBackgroundEnabled),
+      ppuSpritesEnabled(other.ppuSpritesEnabled),
+      ppuTallSprites(other.ppuTallSprites),
+      ppuBackgroundPalette(other.ppuBackgroundPalette),
+      ppuSpritePalettes(other.ppuSpritePalettes),
+      tileCache(other.tileCache),
+      frameBuffer(other.frameBuffer),
+      frameSkip(other.frameSkip),
+      frameSkipRequiresCallback(other.frameSkipRequiresCallback),
+      renderingFrame(other.renderingFrame),
+      lineIndices(other.lineIndices),
+      windowLine(other.windowLine),
+      sprites(other.sprites),
+      spriteCount(other.spriteCount),
+      spriteIndex(other.spriteIndex),
+      graphics(other.graphics),
+      dma(other.dma),
+      timerDivider(other.timerDivider),
+      timerCounter(other.timerCounter),
+      timerModulo(other.timerModulo),
+      timerEnabled(other.timerEnabled),
+      timerClock(other.timerClock),
+      dividerBase(other.dividerBase),
+      timerSyncCycle(other.timerSyncCycle),
+      scheduler(other.scheduler),
+      interrupts(other.interrupts),
+      input(other.input),
+      debugStepping(false),
+      debugPaused(false),
+      colorMode(other.colorMode),
+      doubleSpeed(other.doubleSpeed),
+      infrared(other.infrared),
+      rumble(other.rumble),
+      traceLogging(false),
+      profiling(false),
+      tileViewer(other.tileViewer),
+      spriteViewer(other.spriteViewer),
+      paletteViewer(other.paletteViewer),
+      vramViewer(other.vramViewer),
+      performanceCounter(other.performanceCounter),
+      instructionCount(other.instructionCount),
+      cycleCount(other.cycleCount),
+      frameCount(other.frameCount),
+      audioChannels(other.audioChannels),
+      audioWaveforms(other.audioWaveforms) {
+    watchedReadPages.fill(nullptr);
+    watchedWritePages.fill(nullptr);
+    debugHooks.setStopFlag(&breakBlock);
+    // Builds the page table, and the recompiler if the parent had one
+    setExecutionMode(other.executionMode);
 }
 
-bool GameBoyEmulator::validateROM(const std::vector<uint8_t>& data) const {
+std::unique_ptr<ConsoleEmulator> GameBoyEmulator::fork() {
+    std::unique_ptr<ConsoleEmulator> child(new GameBoyEmulator(*this));
+    // Our memory is shared now, so the page table's write pointers are stale
+    updateMemoryMap();
+    return child;
+}
+
+bool GameBoyEmulator::validateROM(const RomImage& data) const {
     // Check minimum size
     if (data.size() < 0x150) {
         return false;
@@ -98,17 +485,17 @@ bool GameBoyEmulator::validateROM(const std::vector<uint8_t>& data) const {
         0x03, 0x73, 0x00, 0x83, 0x00, 0x0C, 0x00, 0x0D
     };
     
-    return std::memcmp(&data[0x104], NINTENDO_LOGO, sizeof(NINTENDO_LOGO)) == 0;
+    return std::memcmp(data.data() + 0x104, NINTENDO_LOGO, sizeof(NINTENDO_LOGO)) == 0;
 }
 
-bool GameBoyEmulator::detectConsoleType(const std::vector<uint8_t>& data) const {
+bool GameBoyEmulator::detectConsoleType(const RomImage& data) const {
     return validateROM(data);
 }
 
 void GameBoyEmulator::initializeRegisters() {
     registers = {};  // Zero initialize
     registers.a = 0x01;
-    registers.f = 0xB0;
+    setFlags(0xB0);
     registers.b = 0x00;
     registers.c = 0x13;
     registers.d = 0x00;
@@ -118,20 +505,1409 @@ void GameBoyEmulator::initializeRegisters() {
     registers.sp = 0xFFFE;
     registers.pc = 0x0100;
 
-    gpu = {};  // Zero initialize
+    halted = false;
+    stopped = false;
+    unknownOpcodeCount = 0;
+    interrupts = {};
+    input = {0x0F, 0x0F};
 }
 
-void GameBoyEmulator::executeInstruction() {
-    // Fetch
-    uint8_t opcode = readMemory(registers.pc++);
-    
-    // Decode and execute
-    switch (opcode) {
-        // TODO: Implement GameBoy CPU instructions
-        case 0x00:  // NOP
+void GameBoyEmulator::initializeHardware() {
+    // Memory bus
+    cartridge.reset();
+    blockCache.clear();
+    if (recompiler) {
+        recompiler->reset();
+    }
+    breakBlock = false;
+    blockDeadline = 0;
+    watchedReadPages.fill(nullptr);
+    watchedWritePages.fill(nullptr);
+    updateMemoryMap();
+
+    scheduler.reset();
+    cycleCount = 0;
+    instructionCount = 0;
+    frameCount = 0;
+
+    // Timer
+    timerCounter = 0;
+    timerModulo = 0;
+    timerEnabled = false;
+    timerClock = 0;
+    dividerBase = 0;
+    timerSyncCycle = 0;
+
+    // PPU and DMA, left in the post-boot state with the LCD on
+    graphics = {};
+    dma = {};
+    ppuEnabled = false;
+    ppuTallSprites = false;
+    windowLine = 0;
+    spriteIndex.rebuild(oam.data(), false);
+    ppuMode = PPUMode::HBLANK;
+    beginFrame();
+    writeIO(0x40, 0x91);
+    writeIO(0x47, 0xFC);
+}
+
+uint64_t GameBoyEmulator::getInstructionCount() const {
+    return instructionCount;
+}
+
+uint64_t GameBoyEmulator::getCycleCount() const {
+    return cycleCount;
+}
+
+uint64_t GameBoyEmulator::getUnknownOpcodeCount() const {
+    return unknownOpcodeCount;
+}
+
+void GameBoyEmulator::setExecutionMode(ExecutionMode mode) {
+    if (mode == ExecutionMode::DYNAREC) {
+        if (!Recompiler::isSupported()) {
+            mode = ExecutionMode::INTERPRETER;
+        } else if (!recompiler) {
+            Recompiler::Context context = {
+                this,
+                &registers.pc,
+                {&registers.b, &registers.c, &registers.d, &registers.e,
+                 &registers.h, &registers.l, nullptr, &registers.a},
+                &breakBlock,
+                &instructionCount,
+                &cycleCount,
+                &blockDeadline
+            };
+            recompiler = std::make_unique<Recompiler>(context);
+        }
+    }
+
+    executionMode = mode;
+    blockCache.clear();
+    if (recompiler) {
+        recompiler->reset();
+    }
+    updateMemoryMap();
+}
+
+int GameBoyEmulator::executeInstruction() {
+    // Fetch opcode and immediate operand, then dispatch through the table
+    if (debugHooks.isArmed() && debugHooks.isSet(DebugHooks::EXECUTE, registers.pc)) {
+        debugHooks.notify(DebugHooks::EXECUTE, registers.pc, peekMemory(registers.pc));
+        debugHooks.rethrowPending();  // A throwing breakpoint stops before the instruction
+    }
+
+    uint8_t opcode = busRead(registers.pc);
+    uint8_t length = SM83::instructionLength(opcode);
+    uint16_t operand = 0;
+    if (length == 2) {
+        operand = busRead(registers.pc + 1);
+    } else if (length == 3) {
+        operand = readWord(registers.pc + 1);
+    }
+    if (traceLogging) {
+        recordTrace(opcode, operand, length);
+    }
+    registers.pc += length;
+
+    return SM83::opcodeTable[opcode](*this, operand);
+}
+
+int GameBoyEmulator::executeProfiled() {
+    uint16_t pc = registers.pc;
+    uint16_t bank = getBankForAddress(pc);
+    int cycles = executeInstruction();
+    profiler.record(bank, pc, 1, cycles);
+    return cycles;
+}
+
+void GameBoyEmulator::setProfiling(bool enabled) {
+    profiling = enabled;
+}
+
+std::string GameBoyEmulator::getProfileReport(size_t limit) const {
+    return profiler.report(limit, [this](const Profiler::HotSpot& spot) {
+        // Only the bank currently mapped can be read back
+        if (spot.bank != getBankForAddress(spot.address)) {
+            return std::string("(bank not mapped)");
+        }
+        return getDisassembly(spot.address);
+    });
+}
+
+std::string GameBoyEmulator::getDisassembly(uint16_t address) const {
+    auto peek = [this](uint16_t at) { return peekMemory(at); };
+    return disassembler.disassemble(getBankForAddress(address), address, peek).text;
+}
+
+std::vector<Disassembler::Line> GameBoyEmulator::getDisassembly(uint16_t address, size_t count) const {
+    auto peek = [this](uint16_t at) { return peekMemory(at); };
+    std::vector<Disassembler::Line> lines;
+    lines.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        lines.push_back(disassembler.disassemble(getBankForAddress(address), address, peek));
+        address += lines.back().length;
+    }
+    return lines;
+}
+
+// Takes the bytes executeInstruction() already fetched; reading them again
+// would repeat I/O side effects and read watchpoints
+void GameBoyEmulator::recordTrace(uint8_t opcode, uint16_t operand, uint8_t length) {
+    TraceRecord entry;
+    entry.cycle = cycleCount;
+    entry.pc = registers.pc;
+    entry.af = getAF();
+    entry.bc = registers.bc;
+    entry.de = registers.de;
+    entry.hl = registers.hl;
+    entry.sp = registers.sp;
+    entry.length = length;
+    entry.opcode[0] = opcode;
+    entry.opcode[1] = length > 1 ? static_cast<uint8_t>(operand) : 0;
+    entry.opcode[2] = length > 2 ? static_cast<uint8_t>(operand >> 8) : 0;
+    traceLog.record(entry);
+}
+
+void GameBoyEmulator::setTraceLogging(bool enabled) {
+    traceLogging = enabled;
+}
+
+bool GameBoyEmulator::isTraceLogging() const {
+    return traceLogging;
+}
+
+bool GameBoyEmulator::setTraceFile(const std::string& filepath) {
+    return traceLog.open(filepath);
+}
+
+void GameBoyEmulator::closeTraceFile() {
+    traceLog.close();
+}
+
+void GameBoyEmulator::clearTraceLog() {
+    traceLog.clear();
+}
+
+// Block cache
+//
+// Interrupts and scheduled events are only serviced between blocks, so a
+// block advances cycleCount after every instruction and stops once it
+// reaches the next event. I/O writes, which may schedule an earlier event
+// or raise an interrupt, and writes to IE or to the block's own code stop
+// it early. Timer reads and writes thus see the same cycle count as in the
+// interpreter.
+int GameBoyEmulator::executeBlock() {
+    // Echo RAM, OAM and HRAM code is rare and not worth tracking
+    if (registers.pc >= 0xE000) {
+        instructionCount++;
+        return executeInstruction();
+    }
+
+    uint32_t key = BlockCache::makeKey(getBankForAddress(registers.pc), registers.pc);
+    const BlockCache::Block* block = blockCache.find(key);
+    if (!block) {
+        block = compileBlock(key);
+    }
+
+    // Watchpoints fire from the bus either way; breakpoints need the
+    // interpreter's per-instruction check
+    if (debugHooks.isArmed() && debugHooks.anySet(DebugHooks::EXECUTE, block->startPC, block->endPC)) {
+        instructionCount++;
+        return executeInstruction();
+    }
+
+    breakBlock = false;
+    blockDeadline = scheduler.nextEventTime();
+    if (block->native) {
+        block->native();
+        return 0;
+    }
+
+    for (const BlockCache::Instruction& instruction : block->instructions) {
+        registers.pc += instruction.length;
+        cycleCount += instruction.handler(*this, instruction.operand);
+        instructionCount++;
+        if (breakBlock || cycleCount >= blockDeadline) {
+            break;
+        }
+    }
+    return 0;
+}
+
+const BlockCache::Block* GameBoyEmulator::compileBlock(uint32_t key) {
+    BlockCache::Block block;
+    uint16_t pc = registers.pc;
+    block.startPC = pc;
+
+    // Decode up to the first block-ending instruction or the end of the page
+    while (block.instructions.size() < BlockCache::MAX_BLOCK_INSTRUCTIONS) {
+        // Decoding isn't a CPU access, so it mustn't trip read watchpoints
+        uint8_t opcode = peekMemory(pc);
+        uint8_t length = SM83::instructionLength(opcode);
+        uint16_t operand = 0;
+        if (length == 2) {
+            operand = peekMemory(pc + 1);
+        } else if (length == 3) {
+            operand = peekMemory(pc + 1) | (peekMemory(pc + 2) << 8);
+        }
+        block.instructions.push_back({SM83::opcodeTable[opcode], operand, opcode, length});
+
+        pc += length;
+        if (SM83::endsBlock(opcode) || (pc >> MEMORY_PAGE_SHIFT) != (block.startPC >> MEMORY_PAGE_SHIFT)) {
+            break;
+        }
+    }
+    block.endPC = pc;
+
+    if (executionMode == ExecutionMode::DYNAREC) {
+        block.native = recompiler->compile(block);
+        if (!block.native) {
+            // Code cache full: start over rather than tracking free space
+            blockCache.clear();
+            recompiler->reset();
+            updateMemoryMap();
+            block.native = recompiler->compile(block);
+        }
+    }
+
+    // Writes to RAM holding this code must come through writeMemorySlow()
+    const BlockCache::Block* cached = blockCache.insert(key, std::move(block));
+    if (cached->startPC >= 0x8000) {
+        updateMemoryMap();
+    }
+    return cached;
+}
+
+uint16_t GameBoyEmulator::getBankForAddress(uint16_t address) const {
+    if (address < 0x4000) {
+        return cartridge.getRomBank0();
+    } else if (address < 0x8000) {
+        return cartridge.getRomBank();
+    } else if (address >= 0xA000 && address < 0xC000) {
+        return cartridge.getRamBank();
+    }
+    return 0;
+}
+
+int GameBoyEmulator::handleInterrupts() {
+    uint8_t pending = interrupts.flags & interrupts.enable & 0x1F;
+    if (!pending) {
+        return 0;
+    }
+
+    // Any pending interrupt wakes the CPU, even with IME clear
+    halted = false;
+    if (!interrupts.master) {
+        return 0;
+    }
+
+    uint8_t index = 0;
+    while (!(pending & (1 << index))) {
+        index++;
+    }
+
+    interrupts.master = false;
+    interrupts.flags &= ~(1 << index);
+    pushWord(registers.pc);
+    registers.pc = 0x40 + index * 8;
+    return 20;
+}
+
+uint16_t GameBoyEmulator::readWord(uint16_t address) const {
+    return busRead(address) | (busRead(address + 1) << 8);
+}
+
+void GameBoyEmulator::writeWord(uint16_t address, uint16_t value) {
+    busWrite(address, value & 0xFF);
+    busWrite(address + 1, value >> 8);
+}
+
+void GameBoyEmulator::pushWord(uint16_t value) {
+    registers.sp -= 2;
+    writeWord(registers.sp, value);
+}
+
+uint16_t GameBoyEmulator::popWord() {
+    uint16_t value = readWord(registers.sp);
+    registers.sp += 2;
+    return value;
+}
+
+// Register access
+uint16_t GameBoyEmulator::getPC() const { return registers.pc; }
+uint16_t GameBoyEmulator::getSP() const { return registers.sp; }
+uint8_t GameBoyEmulator::getA() const { return registers.a; }
+uint8_t GameBoyEmulator::getB() const { return registers.b; }
+uint8_t GameBoyEmulator::getC() const { return registers.c; }
+uint8_t GameBoyEmulator::getD() const { return registers.d; }
+uint8_t GameBoyEmulator::getE() const { return registers.e; }
+uint8_t GameBoyEmulator::getH() const { return registers.h; }
+uint8_t GameBoyEmulator::getL() const { return registers.l; }
+uint16_t GameBoyEmulator::getAF() const { return (registers.a << 8) | getFlags(); }
+uint16_t GameBoyEmulator::getBC() const { return registers.bc; }
+uint16_t GameBoyEmulator::getDE() const { return registers.de; }
+uint16_t GameBoyEmulator::getHL() const { return registers.hl; }
+
+void GameBoyEmulator::setAF(uint16_t value) {
+    registers.a = value >> 8;
+    setFlags(value & 0xFF);
+}
+
+// Flags
+//
+// Flags are evaluated lazily: the ALU records the result and operands of the
+// last operation that defined each flag, and the getters derive the flag bit
+// only when a conditional instruction, PUSH AF or the debugger asks for it.
+// Half-carry and carry use the usual (a ^ b ^ result) carry-chain identity,
+// which holds for both addition and subtraction.
+bool GameBoyEmulator::getZeroFlag() const {
+    return lazyFlags.zero == 0;
+}
+
+bool GameBoyEmulator::getSubtractFlag() const {
+    return lazyFlags.subtract;
+}
+
+bool GameBoyEmulator::getHalfCarryFlag() const {
+    return lazyFlags.halfSource & lazyFlags.halfMask;
+}
+
+bool GameBoyEmulator::getCarryFlag() const {
+    return lazyFlags.carrySource & lazyFlags.carryMask;
+}
+
+uint8_t GameBoyEmulator::getFlags() const {
+    return (getZeroFlag() ? 0x80 : 0) |
+           (getSubtractFlag() ? 0x40 : 0) |
+           (getHalfCarryFlag() ? 0x20 : 0) |
+           (getCarryFlag() ? 0x10 : 0);
+}
+
+void GameBoyEmulator::setFlags(uint8_t value) {
+    setZeroFlag(value & 0x80);
+    setSubtractFlag(value & 0x40);
+    setHalfCarryFlag(value & 0x20);
+    setCarryFlag(value & 0x10);
+}
+
+void GameBoyEmulator::setZeroFlag(bool set) {
+    lazyFlags.zero = set ? 0 : 1;
+}
+
+void GameBoyEmulator::setSubtractFlag(bool set) {
+    lazyFlags.subtract = set;
+}
+
+void GameBoyEmulator::setHalfCarryFlag(bool set) {
+    lazyFlags.halfSource = set ? 1 : 0;
+    lazyFlags.halfMask = 1;
+}
+
+void GameBoyEmulator::setCarryFlag(bool set) {
+    lazyFlags.carrySource = set ? 1 : 0;
+    lazyFlags.carryMask = 1;
+}
+
+// CPU Operations
+uint8_t GameBoyEmulator::inc(uint8_t value) {
+    uint8_t result = value + 1;
+    lazyFlags.zero = result;
+    lazyFlags.subtract = false;
+    lazyFlags.halfSource = value ^ 1 ^ result;
+    lazyFlags.halfMask = 0x10;
+    return result;
+}
+
+uint8_t GameBoyEmulator::dec(uint8_t value) {
+    uint8_t result = value - 1;
+    lazyFlags.zero = result;
+    lazyFlags.subtract = true;
+    lazyFlags.halfSource = value ^ 1 ^ result;
+    lazyFlags.halfMask = 0x10;
+    return result;
+}
+
+void GameBoyEmulator::add8(uint8_t value) {
+    uint16_t result = registers.a + value;
+    lazyFlags.zero = static_cast<uint8_t>(result);
+    lazyFlags.subtract = false;
+    lazyFlags.halfSource = registers.a ^ value ^ result;
+    lazyFlags.halfMask = 0x10;
+    lazyFlags.carrySource = result;
+    lazyFlags.carryMask = 0x100;
+    registers.a = static_cast<uint8_t>(result);
+}
+
+void GameBoyEmulator::adc8(uint8_t value) {
+    uint16_t result = registers.a + value + (getCarryFlag() ? 1 : 0);
+    lazyFlags.zero = static_cast<uint8_t>(result);
+    lazyFlags.subtract = false;
+    lazyFlags.halfSource = registers.a ^ value ^ result;
+    lazyFlags.halfMask = 0x10;
+    lazyFlags.carrySource = result;
+    lazyFlags.carryMask = 0x100;
+    registers.a = static_cast<uint8_t>(result);
+}
+
+void GameBoyEmulator::sub8(uint8_t value) {
+    cp8(value);
+    registers.a -= value;
+}
+
+void GameBoyEmulator::sbc8(uint8_t value) {
+    // Borrow shows up in bit 8 of the 16-bit difference
+    uint16_t result = registers.a - value - (getCarryFlag() ? 1 : 0);
+    lazyFlags.zero = static_cast<uint8_t>(result);
+    lazyFlags.subtract = true;
+    lazyFlags.halfSource = registers.a ^ value ^ result;
+    lazyFlags.halfMask = 0x10;
+    lazyFlags.carrySource = result;
+    lazyFlags.carryMask = 0x100;
+    registers.a = static_cast<uint8_t>(result);
+}
+
+void GameBoyEmulator::and8(uint8_t value) {
+    registers.a &= value;
+    lazyFlags.zero = registers.a;
+    lazyFlags.subtract = false;
+    setHalfCarryFlag(true);
+    setCarryFlag(false);
+}
+
+void GameBoyEmulator::xor8(uint8_t value) {
+    registers.a ^= value;
+    lazyFlags.zero = registers.a;
+    lazyFlags.subtract = false;
+    setHalfCarryFlag(false);
+    setCarryFlag(false);
+}
+
+void GameBoyEmulator::or8(uint8_t value) {
+    registers.a |= value;
+    lazyFlags.zero = registers.a;
+    lazyFlags.subtract = false;
+    setHalfCarryFlag(false);
+    setCarryFlag(false);
+}
+
+void GameBoyEmulator::cp8(uint8_t value) {
+    uint16_t result = registers.a - value;
+    lazyFlags.zero = static_cast<uint8_t>(result);
+    lazyFlags.subtract = true;
+    lazyFlags.halfSource = registers.a ^ value ^ result;
+    lazyFlags.halfMask = 0x10;
+    lazyFlags.carrySource = result;
+    lazyFlags.carryMask = 0x100;
+}
+
+uint8_t GameBoyEmulator::rlc(uint8_t value) {
+    uint8_t result = (value << 1) | (value >> 7);
+    setShiftFlags(result, value, 0x80);
+    return result;
+}
+
+uint8_t GameBoyEmulator::rrc(uint8_t value) {
+    uint8_t result = (value >> 1) | (value << 7);
+    setShiftFlags(result, value, 0x01);
+    return result;
+}
+
+uint16_t GameBoyEmulator::add16(uint16_t a, uint16_t b) {
+    uint32_t result = a + b;
+    lazyFlags.subtract = false;
+    lazyFlags.halfSource = a ^ b ^ result;
+    lazyFlags.halfMask = 0x1000;
+    lazyFlags.carrySource = result;
+    lazyFlags.carryMask = 0x10000;
+    return static_cast<uint16_t>(result);
+}
+
+uint16_t GameBoyEmulator::addSP(int8_t offset) {
+    // Flags come from the unsigned low-byte addition
+    uint16_t sp = registers.sp;
+    uint8_t value = static_cast<uint8_t>(offset);
+    uint16_t low = (sp & 0xFF) + value;
+    lazyFlags.zero = 1;
+    lazyFlags.subtract = false;
+    lazyFlags.halfSource = sp ^ value ^ low;
+    lazyFlags.halfMask = 0x10;
+    lazyFlags.carrySource = low;
+    lazyFlags.carryMask = 0x100;
+    return static_cast<uint16_t>(sp + offset);
+}
+
+// Additional CPU Operations
+uint8_t GameBoyEmulator::rl(uint8_t value) {
+    uint8_t result = (value << 1) | (getCarryFlag() ? 1 : 0);
+    setShiftFlags(result, value, 0x80);
+    return result;
+}
+
+uint8_t GameBoyEmulator::rr(uint8_t value) {
+    uint8_t result = (value >> 1) | (getCarryFlag() ? 0x80 : 0);
+    setShiftFlags(result, value, 0x01);
+    return result;
+}
+
+uint8_t GameBoyEmulator::sla(uint8_t value) {
+    uint8_t result = value << 1;
+    setShiftFlags(result, value, 0x80);
+    return result;
+}
+
+uint8_t GameBoyEmulator::sra(uint8_t value) {
+    uint8_t result = (value >> 1) | (value & 0x80);
+    setShiftFlags(result, value, 0x01);
+    return result;
+}
+
+uint8_t GameBoyEmulator::swap(uint8_t value) {
+    uint8_t result = (value << 4) | (value >> 4);
+    setShiftFlags(result, 0, 0);
+    return result;
+}
+
+uint8_t GameBoyEmulator::srl(uint8_t value) {
+    uint8_t result = value >> 1;
+    setShiftFlags(result, value, 0x01);
+    return result;
+}
+
+void GameBoyEmulator::setShiftFlags(uint8_t result, uint8_t value, uint8_t carryBit) {
+    // Rotates and shifts: Z from the result, N and H cleared, C is the bit shifted out
+    lazyFlags.zero = result;
+    lazyFlags.subtract = false;
+    lazyFlags.halfSource = 0;
+    lazyFlags.carrySource = value;
+    lazyFlags.carryMask = carryBit;
+}
+
+void GameBoyEmulator::bit(uint8_t index, uint8_t value) {
+    lazyFlags.zero = value & (1 << index);
+    lazyFlags.subtract = false;
+    setHalfCarryFlag(true);
+}
+
+void GameBoyEmulator::daa() {
+    uint8_t a = registers.a;
+    if (!getSubtractFlag()) {
+        if (getCarryFlag() || a > 0x99) {
+            a += 0x60;
+            setCarryFlag(true);
+        }
+        if (getHalfCarryFlag() || (a & 0x0F) > 0x09) {
+            a += 0x06;
+        }
+    } else {
+        if (getCarryFlag()) {
+            a -= 0x60;
+        }
+        if (getHalfCarryFlag()) {
+            a -= 0x06;
+        }
+    }
+    setZeroFlag(a == 0);
+    setHalfCarryFlag(false);
+    registers.a = a;
+}
+
+// Accesses whose page has no direct pointer
+uint8_t GameBoyEmulator::readMemorySlow(uint16_t address) const {
+    const uint8_t* watched = watchedReadPages[address >> MEMORY_PAGE_SHIFT];
+    uint8_t value = watched ? watched[address & 0xFF] : readUnmapped(address);
+    if (debugHooks.isArmed() && debugHooks.isSet(DebugHooks::READ, address)) {
+        debugHooks.notify(DebugHooks::READ, address, value);
+    }
+    return value;
+}
+
+uint8_t GameBoyEmulator::peekMemory(uint16_t address) const {
+    const uint8_t* page = readPages[address >> MEMORY_PAGE_SHIFT];
+    if (!page) {
+        page = watchedReadPages[address >> MEMORY_PAGE_SHIFT];
+    }
+    return page ? page[address & 0xFF] : readUnmapped(address);
+}
+
+uint8_t GameBoyEmulator::readUnmapped(uint16_t address) const {
+    if (address < 0x8000) {
+        return 0xFF; // ROM is always mapped
+    } else if (address >= 0xA000 && address < 0xC000) {
+        return cartridge.readRam(address); // Disabled, MBC2 or clock registers
+    } else if (address < 0xFE00) {
+        return 0xFF;
+    } else if (address < 0xFEA0) {
+        return oam[address - 0xFE00];
+    } else if (address < 0xFF00) {
+        return 0; // Unused
+    } else if (address < 0xFF80) {
+        return readIO(address - 0xFF00);
+    } else if (address < 0xFFFF) {
+        return hram[address - 0xFF80];
+    } else {
+        return interrupts.enable;
+    }
+}
+
+void GameBoyEmulator::writeMemorySlow(uint16_t address, uint8_t value) {
+    if (debugHooks.isArmed() && debugHooks.isSet(DebugHooks::WRITE, address)) {
+        debugHooks.notify(DebugHooks::WRITE, address, value);
+    }
+
+    // First write to a clean battery RAM page since the last flush
+    if (address >= 0xA000 && address < 0xC000 && saveRam.isOpen()) {
+        size_t offset = cartridge.ramOffset(address);
+        if (offset != Cartridge::NO_RAM && !saveRam.isDirty(offset)) {
+            saveRam.markDirty(offset);
+            remapCartridge();
+            if (writePages[address >> MEMORY_PAGE_SHIFT]) {
+                writePages[address >> MEMORY_PAGE_SHIFT][address & 0xFF] = value;
+                return;
+            }
+        }
+    }
+
+    // Self-modifying code: drop the page's blocks and restore its write pointer
+    uint8_t page = address >> MEMORY_PAGE_SHIFT;
+    uint8_t codePage = (address >= 0xE000 && address < 0xFE00) ? page - 0x20 : page;
+    if (address >= 0x8000 && blockCache.isCodePage(codePage)) {
+        blockCache.invalidatePage(codePage);
+        breakBlock = true;
+        updateMemoryMap();
+        if (writePages[page]) {
+            writePages[page][address & 0xFF] = value;
+            return;
+        }
+    }
+
+    if (watchedWritePages[page]) {
+        watchedWritePages[page][address & 0xFF] = value;
+        return;
+    }
+
+    if (address < 0x8000) {
+        switchBanks(address, value);
+    } else if (address < 0xA000) {
+        if (!vram.writePointer(0)) {
+            // Shared with a fork: take our own copy and map that instead
+            vram.makeWritable(0);
+            updateMemoryMap();
+        }
+        vram.write(address - 0x8000, value);
+        updateTileData(address);
+    } else if (address < 0xC000) {
+        bool shared = cartridge.ramWindow() && !cartridge.ramWriteWindow();
+        cartridge.writeRam(address, value);
+        if (shared) {
+            remapCartridge();
+        }
+    } else if (address < 0xFE00) {
+        // Work RAM pages get here while they are shared with a fork
+        CowMemory& bank = (address & 0x1000) ? wramBankN : wramBank0;
+        if (bank.size() >= 0x1000) {
+            bank.write(address & 0x0FFF, value);
+            updateMemoryMap();
+        }
+    } else if (address < 0xFEA0) {
+        oam[address - 0xFE00] = value;
+        updateOAM(address - 0xFE00);
+    } else if (address < 0xFF00) {
+        // Unused
+        return;
+    } else if (address < 0xFF80) {
+        writeIO(address - 0xFF00, value);
+    } else if (address < 0xFFFF) {
+        hram[address - 0xFF80] = value;
+    } else {
+        interrupts.enable = value;
+        breakBlock = true;
+    }
+}
+
+// Point pages [start, end) at base, which holds the byte for address start
+void GameBoyEmulator::mapPages(uint16_t start, uint32_t end, uint8_t* base, bool writable) {
+    for (uint32_t address = start; address < end; address += MEMORY_PAGE_SIZE) {
+        uint8_t* page = base + (address - start);
+        readPages[address >> MEMORY_PAGE_SHIFT] = page;
+        writePages[address >> MEMORY_PAGE_SHIFT] = writable ? page : nullptr;
+    }
+}
+
+// Same for copy-on-write memory starting at address start. Pages shared
+// with a fork stay off the fast path for writes until they are unshared.
+void GameBoyEmulator::mapPages(uint16_t start, uint32_t end, const CowMemory& memory, bool writable) {
+    for (uint32_t address = start; address < end; address += MEMORY_PAGE_SIZE) {
+        size_t offset = address - start;
+        size_t inPage = offset & (memory.pageSize() - 1);
+        uint8_t* page = writable ? memory.writePointer(offset) : nullptr;
+        readPages[address >> MEMORY_PAGE_SHIFT] = memory.readPointer(offset) + inPage;
+        writePages[address >> MEMORY_PAGE_SHIFT] = page ? page + inPage : nullptr;
+    }
+}
+
+void GameBoyEmulator::mapReadOnlyPages(uint16_t start, uint32_t end, const uint8_t* base) {
+    for (uint32_t address = start; address < end; address += MEMORY_PAGE_SIZE) {
+        readPages[address >> MEMORY_PAGE_SHIFT] = base + (address - start);
+        writePages[address >> MEMORY_PAGE_SHIFT] = nullptr;
+    }
+}
+
+void GameBoyEmulator::unmapPages(uint16_t start, uint32_t end) {
+    for (uint32_t address = start; address < end; address += MEMORY_PAGE_SIZE) {
+        readPages[address >> MEMORY_PAGE_SHIFT] = nullptr;
+        writePages[address >> MEMORY_PAGE_SHIFT] = nullptr;
+    }
+}
+
+// Rebuild the page table. Called on reset and when watchpoints change; bank
+// switches only remap the cartridge windows. The bus itself never branches
+// on banking state.
+void GameBoyEmulator::updateMemoryMap() {
+    mapCartridge();
+
+    // VRAM reads are direct; writes go through updateTileData()
+    mapPages(0x8000, 0xA000, vram, false);
+
+    // Work RAM and its echo at E000-FDFF
+    mapPages(0xC000, 0xD000, wramBank0, true);
+    mapPages(0xE000, 0xF000, wramBank0, true);
+    if (wramBankN.size() >= 0x1000) {
+        mapPages(0xD000, 0xE000, wramBankN, true);
+        mapPages(0xF000, 0xFE00, wramBankN, true);
+    } else {
+        unmapPages(0xD000, 0xE000);
+        unmapPages(0xF000, 0xFE00);
+    }
+
+    // OAM, I/O and HRAM share pages with side-effecting registers
+    unmapPages(0xFE00, 0x10000);
+
+    protectPages(0x00, MEMORY_PAGE_COUNT);
+}
+
+// Point 0000-7FFF and A000-BFFF at the banks the mapper selects
+void GameBoyEmulator::mapCartridge() {
+    mapReadOnlyPages(0x0000, 0x4000, cartridge.romBank0Window());
+    mapReadOnlyPages(0x4000, 0x8000, cartridge.romBankNWindow());
+    if (const uint8_t* ram = cartridge.ramWindow()) {
+        // Read-only while the bank is shared with a fork
+        mapReadOnlyPages(0xA000, 0xC000, ram);
+        if (uint8_t* writable = cartridge.ramWriteWindow()) {
+            mapPages(0xA000, 0xC000, writable, true);
+        }
+    } else {
+        unmapPages(0xA000, 0xC000);
+    }
+}
+
+// Take pages in [first, end) that need to see accesses off the fast path
+void GameBoyEmulator::protectPages(int first, int end) {
+    // Keep writes to cached RAM code, and its echo, on the slow path
+    for (int page = std::max(first, 0x8000 >> MEMORY_PAGE_SHIFT); page < std::min(end, 0xE000 >> MEMORY_PAGE_SHIFT); page++) {
+        if (blockCache.isCodePage(page)) {
+            writePages[page] = nullptr;
+            if (page >= (0xC000 >> MEMORY_PAGE_SHIFT) && page < (0xDE00 >> MEMORY_PAGE_SHIFT)) {
+                writePages[page + 0x20] = nullptr;
+            }
+        }
+    }
+
+    // Battery RAM pages stay read-only until written, so the first write
+    // to a page after each flush marks it dirty
+    if (saveRam.isOpen() && cartridge.ramWindow()) {
+        for (int page = std::max(first, 0xA000 >> MEMORY_PAGE_SHIFT); page < std::min(end, 0xC000 >> MEMORY_PAGE_SHIFT); page++) {
+            if (!saveRam.isDirty(cartridge.ramOffset(page << MEMORY_PAGE_SHIFT))) {
+                writePages[page] = nullptr;
+            }
+        }
+    }
+
+    // Move pages with watchpoints off the fast path
+    if (debugHooks.isArmed()) {
+        for (int page = first; page < end; page++) {
+            if (debugHooks.watchesPage(DebugHooks::READ, page)) {
+                watchedReadPages[page] = readPages[page];
+                readPages[page] = nullptr;
+            }
+            if (debugHooks.watchesPage(DebugHooks::WRITE, page)) {
+                watchedWritePages[page] = writePages[page];
+                writePages[page] = nullptr;
+            }
+        }
+    }
+}
+
+// Mapper register write: repoint the cartridge windows, copying nothing
+void GameBoyEmulator::switchBanks(uint16_t address, uint8_t value) {
+    cartridge.updateClock(cycleCount);
+    if (!cartridge.writeRegister(address, value)) {
+        return;
+    }
+    remapCartridge();
+    // The running block may have been decoded from the old bank
+    breakBlock = true;
+}
+
+void GameBoyEmulator::remapCartridge() {
+    mapCartridge();
+    protectPages(0x0000 >> MEMORY_PAGE_SHIFT, 0x8000 >> MEMORY_PAGE_SHIFT);
+    protectPages(0xA000 >> MEMORY_PAGE_SHIFT, 0xC000 >> MEMORY_PAGE_SHIFT);
+}
+
+bool GameBoyEmulator::setSaveFile(const std::string& filepath) {
+    if (!batteryBacked || !saveRam.open(filepath, cartridge.getRam())) {
+        return false;
+    }
+    savePath = filepath;
+    remapCartridge();
+    return true;
+}
+
+void GameBoyEmulator::flushSaveFile() {
+    commitSaveRam(true);
+}
+
+std::string GameBoyEmulator::defaultSaveFile(const std::string& romPath) {
+    size_t slash = romPath.find_last_of("/\\");
+    size_t dot = romPath.rfind('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return romPath + ".sav";
+    }
+    return romPath.substr(0, dot) + ".sav";
+}
+
+// Once a frame: hand dirty battery RAM to the writer and write-protect
+// the pages again so the next change is noticed
+void GameBoyEmulator::commitSaveRam(bool force) {
+    if (saveRam.commit(cartridge.getRam(), force)) {
+        remapCartridge();
+    }
+}
+
+// Rebuild the page table after watchpoints change
+void GameBoyEmulator::updateDebugHooks() {
+    watchedReadPages.fill(nullptr);
+    watchedWritePages.fill(nullptr);
+    updateMemoryMap();
+}
+
+// Breakpoints and watchpoints
+void GameBoyEmulator::setBreakpoint(uint16_t address) {
+    debugHooks.set(DebugHooks::EXECUTE, address);
+}
+
+void GameBoyEmulator::setBreakpoint(uint16_t address, std::function<void()> callback) {
+    debugHooks.set(DebugHooks::EXECUTE, address, [callback](uint16_t, uint8_t) {
+        callback();
+    });
+}
+
+void GameBoyEmulator::clearBreakpoint(uint16_t address) {
+    debugHooks.clear(DebugHooks::EXECUTE, address);
+}
+
+void GameBoyEmulator::clearAllBreakpoints() {
+    debugHooks.clearAll(DebugHooks::EXECUTE);
+}
+
+void GameBoyEmulator::setWatchpoint(uint16_t address, std::function<void(uint8_t)> callback) {
+    debugHooks.set(DebugHooks::WRITE, address, [callback](uint16_t, uint8_t value) {
+        callback(value);
+    });
+    updateDebugHooks();
+}
+
+void GameBoyEmulator::setReadWatchpoint(uint16_t address, std::function<void(uint8_t)> callback) {
+    debugHooks.set(DebugHooks::READ, address, [callback](uint16_t, uint8_t value) {
+        callback(value);
+    });
+    updateDebugHooks();
+}
+
+void GameBoyEmulator::clearWatchpoint(uint16_t address) {
+    debugHooks.clear(DebugHooks::READ, address);
+    debugHooks.clear(DebugHooks::WRITE, address);
+    updateDebugHooks();
+}
+
+uint8_t GameBoyEmulator::readIO(uint8_t address) const {
+    switch (address) {
+        case 0x04: // DIV
+            return getDivider();
+        case 0x05: // TIMA
+            return getTimerCounter();
+        case 0x0F: // IF
+            return interrupts.flags | 0xE0;
+        case 0x41: // STAT
+            return graphics.stat | 0x80;
+        case 0x44: // LY
+            return graphics.ly;
+        default:
+            return io[address];
+    }
+}
+
+void GameBoyEmulator::writeIO(uint8_t address, uint8_t value) {
+    // The running block's event deadline may no longer hold
+    breakBlock = true;
+
+    switch (address) {
+        case 0x00: // P1/JOYP
+            io[address] = value;
+            updateJoypad();
+            break;
+        case 0x01: // SB
+            io[address] = value;
+            updateSerial();
+            break;
+        case 0x02: // SC
+            io[address] = value;
+            updateSerial();
+            break;
+        case 0x04: // DIV
+            syncTimer();
+            dividerBase = cycleCount;
+            timerSyncCycle = cycleCount;
+            scheduleTimerOverflow();
+            break;
+        case 0x05: // TIMA
+            syncTimer();
+            timerCounter = value;
+            scheduleTimerOverflow();
+            break;
+        case 0x06: // TMA
+            io[address] = value;
+            timerModulo = value;
+            break;
+        case 0x07: // TAC
+            syncTimer();
+            io[address] = value;
+            updateTimerControl();
+            scheduleTimerOverflow();
+            break;
+        case 0x0F: // IF
+            io[address] = value;
+            updateInterruptFlags();
+            break;
+        case 0x40: // LCDC
+            io[address] = value;
+            updateLCDControl();
+            break;
+        case 0x41: // STAT
+            io[address] = value;
+            graphics.stat = (graphics.stat & 0x07) | (value & 0x78);
+            break;
+        case 0x42: // SCY
+            io[address] = value;
+            updateScroll();
+            break;
+        case 0x43: // SCX
+            io[address] = value;
+            updateScroll();
+            break;
+        case 0x44: // LY
+            io[address] = 0;
+            break;
+        case 0x45: // LYC
+            io[address] = value;
+            graphics.lyc = value;
+            updateLCDStatus();
+            break;
+        case 0x46: // DMA
+            io[address] = value;
+            processDMA();
+            break;
+        case 0x47: // BGP
+            io[address] = value;
+            updatePalettes();
+            break;
+        case 0x48: // OBP0
+            io[address] = value;
+            updatePalettes();
+            break;
+        case 0x49: // OBP1
+            io[address] = value;
+            updatePalettes();
+            break;
+        case 0x4A: // WY
+            io[address] = value;
+            updateWindowPosition();
+            break;
+        case 0x4B: // WX
+            io[address] = value;
+            updateWindowPosition();
             break;
         default:
-            std::cerr << "Unknown opcode: 0x" << std::hex << static_cast<int>(opcode) << std::endl;
+            io[address] = value;
+            break;
+    }
+}
+
+// PPU Functions
+void GameBoyEmulator::updateLCDControl() {
+    bool wasEnabled = ppuEnabled;
+    ppuEnabled = io[0x40] & 0x80;
+    ppuWindowEnabled = io[0x40] & 0x20;
+    ppuSpritesEnabled = io[0x40] & 0x02;
+    ppuBackgroundEnabled = io[0x40] & 0x01;
+
+    bool tallSprites = io[0x40] & 0x04;
+    if (tallSprites != ppuTallSprites) {
+        ppuTallSprites = tallSprites;
+        spriteIndex.rebuild(oam.data(), ppuTallSprites);
+    }
+
+    if (ppuEnabled && !wasEnabled) {
+        // Turning the LCD on restarts the frame at line 0
+        graphics.ly = 0;
+        windowLine = 0;
+        setPPUMode(PPUMode::OAM_SCAN);
+        scheduler.schedule(EVENT_PPU_MODE, cycleCount + OAM_SCAN_CYCLES);
+        updateLCDStatus();
+    } else if (!ppuEnabled && wasEnabled) {
+        graphics.ly = 0;
+        setPPUMode(PPUMode::HBLANK);
+        scheduler.cancel(EVENT_PPU_MODE);
+    }
+}
+
+void GameBoyEmulator::updateLCDStatus() {
+    // LY/LYC compare; only called when either side changes, so the STAT
+    // interrupt fires once on the rising edge of the coincidence flag.
+    if (ppuEnabled) {
+        if (graphics.ly == graphics.lyc) {
+            if (!(graphics.stat & 0x04) && (graphics.stat & 0x40)) {
+                interrupts.flags |= 0x02;
+            }
+            graphics.stat |= 0x04;
+        } else {
+            graphics.stat &= ~0x04;
+        }
+    }
+}
+
+void GameBoyEmulator::updateScroll() {
+    graphics.scx = io[0x43];
+    graphics.scy = io[0x42];
+}
+
+void GameBoyEmulator::updateWindowPosition() {
+    graphics.wx = io[0x4B];
+    graphics.wy = io[0x4A];
+}
+
+void GameBoyEmulator::updatePalettes() {
+    graphics.bgp = io[0x47];
+    graphics.obp0 = io[0x48];
+    graphics.obp1 = io[0x49];
+}
+
+void GameBoyEmulator::updateTileData(uint16_t address) {
+    tileCache.markDirty(0, address - 0x8000);
+}
+
+void GameBoyEmulator::updateOAM(uint8_t offset) {
+    // Only an entry's Y byte moves it between lines
+    if ((offset & 3) == 0) {
+        spriteIndex.update(offset / 4, oam.data(), ppuTallSprites);
+    }
+}
+
+void GameBoyEmulator::processDMA() {
+    uint16_t source = io[0x46] << 8;
+    dma.active = true;
+    dma.source = source;
+    dma.destination = 0xFE00;
+    dma.length = 0xA0;
+    dma.remaining = 0xA0;
+    scheduler.schedule(EVENT_DMA_COMPLETE, cycleCount + DMA_TRANSFER_CYCLES);
+}
+
+void GameBoyEmulator::onDMAComplete() {
+    for (uint16_t i = 0; i < dma.length; i++) {
+        oam[i] = readMemory(dma.source + i);
+    }
+    dma.active = false;
+    dma.remaining = 0;
+    spriteIndex.rebuild(oam.data(), ppuTallSprites);
+}
+
+// Timer Functions
+//
+// TIMA ticks on every multiple of its period measured from the last DIV
+// reset, so both registers are computed from the cycle counter when read.
+// The only scheduled timer event is the TIMA overflow.
+static constexpr int TIMER_PERIOD_SHIFT[4] = {10, 4, 6, 8};  // 1024, 16, 64, 256 cycles
+
+void GameBoyEmulator::updateTimerControl() {
+    timerEnabled = io[0x07] & 0x04;
+    timerClock = io[0x07] & 0x03;
+}
+
+uint8_t GameBoyEmulator::getDivider() const {
+    return static_cast<uint8_t>((cycleCount - dividerBase) >> 8);
+}
+
+uint8_t GameBoyEmulator::getTimerCounter() const {
+    if (!timerEnabled) {
+        return timerCounter;
+    }
+    int shift = TIMER_PERIOD_SHIFT[timerClock];
+    uint64_t ticks = ((cycleCount - dividerBase) >> shift) - ((timerSyncCycle - dividerBase) >> shift);
+    return static_cast<uint8_t>(timerCounter + ticks);
+}
+
+void GameBoyEmulator::syncTimer() {
+    timerCounter = getTimerCounter();
+    timerSyncCycle = cycleCount;
+}
+
+void GameBoyEmulator::scheduleTimerOverflow() {
+    if (!timerEnabled) {
+        scheduler.cancel(EVENT_TIMER_OVERFLOW);
+        return;
+    }
+    int shift = TIMER_PERIOD_SHIFT[timerClock];
+    uint64_t overflowTick = ((timerSyncCycle - dividerBase) >> shift) + (256 - timerCounter);
+    scheduler.schedule(EVENT_TIMER_OVERFLOW, dividerBase + (overflowTick << shift));
+}
+
+void GameBoyEmulator::onTimerOverflow(uint64_t timestamp) {
+    timerCounter = timerModulo;
+    timerSyncCycle = timestamp;
+    interrupts.flags |= 0x04;
+    scheduleTimerOverflow();
+}
+
+void GameBoyEmulator::updateInterruptFlags() {
+    interrupts.flags = io[0x0F] & 0x1F;
+}
+
+void GameBoyEmulator::setJoypad(uint8_t buttons, uint8_t directions) {
+    input.buttons = buttons;
+    input.directions = directions;
+    updateJoypad();
+}
+
+void GameBoyEmulator::updateJoypad() {
+    uint8_t joypad = io[0x00];
+    if (!(joypad & 0x10)) {
+        joypad = (joypad & 0xF0) | (input.buttons & 0x0F);
+    } else if (!(joypad & 0x20)) {
+        joypad = (joypad & 0xF0) | (input.directions & 0x0F);
+    }
+    io[0x00] = joypad;
+}
+
+void GameBoyEmulator::updateSerial() {
+    // TODO: Implement serial transfer
+}
+
+void GameBoyEmulator::renderScanline() {
+    if (!ppuEnabled) return;
+
+    if (ppuMode == PPUMode::OAM_SCAN) {
+        // Find sprites for this scanline
+        findSpritesForScanline();
+    } else if (ppuMode == PPUMode::PIXEL_TRANSFER) {
+        // Background and window color indices, then BGP over the whole line
+        uint8_t* line = &frameBuffer[graphics.ly * SCREEN_WIDTH];
+        if (ppuBackgroundEnabled) {
+            renderBackground();
+            if (ppuWindowEnabled) {
+                renderWindow();
+            }
+            PixelKernels::applyPalette(lineIndices.data(), SCREEN_WIDTH, graphics.bgp, line);
+        } else {
+            lineIndices.fill(0);
+            std::memset(line, 0, SCREEN_WIDTH);
+        }
+        // Render sprites
+        if (ppuSpritesEnabled) {
+            renderSprites();
+        }
+    }
+}
+
+void GameBoyEmulator::findSpritesForScanline() {
+    uint8_t selected[MAX_SPRITES_PER_LINE];
+    spriteCount = spriteIndex.select(graphics.ly, selected, MAX_SPRITES_PER_LINE);
+    for (int i = 0; i < spriteCount; i++) {
+        const uint8_t* entry = &oam[selected[i] * 4];
+        sprites[i].y = entry[0] - 16;
+        sprites[i].x = entry[1] - 8;
+        sprites[i].tile = entry[2];
+        sprites[i].attributes = entry[3];
+    }
+    // DMG priority: lower X first, then lower OAM index, which the stable
+    // sort keeps from the selection order
+    std::stable_sort(sprites.begin(), sprites.begin() + spriteCount,
+                     [](const Sprite& a, const Sprite& b) { return a.x < b.x; });
+}
+
+void GameBoyEmulator::renderBackground() {
+    const uint8_t* tileMap = vram.readPointer(0) + ((io[0x40] & 0x08) ? 0x1C00 : 0x1800);
+    uint8_t y = graphics.scy + graphics.ly;
+    renderTileRow(tileMap + (y / 8) * 32, graphics.scx / 8, graphics.scx & 7, y & 7, 0);
+}
+
+void GameBoyEmulator::renderWindow() {
+    if (graphics.wx > 166 || graphics.ly < graphics.wy) return;
+
+    const uint8_t* tileMap = vram.readPointer(0) + ((io[0x40] & 0x40) ? 0x1C00 : 0x1800);
+    int windowY = windowLine++;
+    int x = std::max(graphics.wx - 7, 0);
+    int windowX = x - (graphics.wx - 7);
+    renderTileRow(tileMap + (windowY / 8) * 32, windowX / 8, windowX & 7, windowY & 7, x);
+}
+
+// Draw one tile map row onto the current line from screen x to the right
+// edge, a whole decoded tile row per copy. Only the first tile is entered
+// part way, by the fine scroll.
+void GameBoyEmulator::renderTileRow(const uint8_t* mapRow, int mapX, int skip, int tileY, int x) {
+    bool unsignedTiles = io[0x40] & 0x10;
+    uint8_t* line = lineIndices.data();
+    while (x < SCREEN_WIDTH) {
+        int tile = TileCache::tileIndex(mapRow[mapX], unsignedTiles);
+        const uint8_t* row = tileCache.row(0, tile, tileY, vram.readPointer(0));
+        int count = std::min(8 - skip, SCREEN_WIDTH - x);
+        std::memcpy(line + x, row + skip, count);
+        x += count;
+        mapX = (mapX + 1) & 31;
+        skip = 0;
+    }
+}
+
+// Drawn from lowest to highest priority, so the winner ends up on top
+void GameBoyEmulator::renderSprites() {
+    int height = ppuTallSprites ? 16 : 8;
+    for (int i = spriteCount - 1; i >= 0; i--) {
+        const Sprite& sprite = sprites[i];
+        bool flipX = sprite.attributes & 0x20;
+        bool flipY = sprite.attributes & 0x40;
+        bool priority = sprite.attributes & 0x80;
+        uint8_t palette = (sprite.attributes & 0x10) ? graphics.obp1 : graphics.obp0;
+
+        // Only the sprite's row on this line is drawn. 8x16 sprites are
+        // an even/odd tile pair, flipped as a whole.
+        int y = graphics.ly - sprite.y;
+        if (flipY) {
+            y = height - 1 - y;
+        }
+        int tile = ppuTallSprites ? (sprite.tile & 0xFE) + (y >> 3) : sprite.tile;
+        const uint8_t* row = tileCache.row(0, tile, y & 7, vram.readPointer(0));
+        for (int x = 0; x < 8; x++) {
+            int screenX = sprite.x + x;
+            uint8_t pixel = row[flipX ? 7 - x : x];
+            if (pixel != 0 && screenX >= 0 && screenX < SCREEN_WIDTH) {
+                // Behind the background unless its color index is 0
+                if (!priority || lineIndices[screenX] == 0) {
+                    setPixel(screenX, graphics.ly, getPaletteColor(palette, pixel));
+                }
+            }
+        }
+    }
+}
+
+uint8_t GameBoyEmulator::getPaletteColor(uint8_t palette, uint8_t color) {
+    return (palette >> (color * 2)) & 0x03;
+}
+
+void GameBoyEmulator::setPixel(int x, int y, uint8_t color) {
+    if (x >= 0 && x < SCREEN_WIDTH && y >= 0 && y < SCREEN_HEIGHT) {
+        frameBuffer[y * SCREEN_WIDTH + x] = color;
+    }
+}
+
+uint8_t GameBoyEmulator::getPixel(int x, int y) const {
+    if (x >= 0 && x < SCREEN_WIDTH && y >= 0 && y < SCREEN_HEIGHT) {
+        return frameBuffer[y * SCREEN_WIDTH + x];
+    }
+    return 0;
+}
+
+// PPU mode sequencing
+//
+// Each mode transition is a scheduled event: OAM scan (80) -> pixel
+// transfer (172) -> HBlank (204) per visible line, then ten 456-cycle
+// VBlank lines. LY, the LYC compare and the STAT/VBlank interrupts are
+// updated only at those transitions.
+void GameBoyEmulator::onPPUModeEvent(uint64_t timestamp) {
+    switch (ppuMode) {
+        case PPUMode::OAM_SCAN:
+            if (renderingFrame) {
+                findSpritesForScanline();
+            }
+            setPPUMode(PPUMode::PIXEL_TRANSFER);
+            scheduler.schedule(EVENT_PPU_MODE, timestamp + PIXEL_TRANSFER_CYCLES);
+            break;
+        case PPUMode::PIXEL_TRANSFER:
+            if (renderingFrame) {
+                renderScanline();
+            }
+            setPPUMode(PPUMode::HBLANK);
+            scheduler.schedule(EVENT_PPU_MODE, timestamp + HBLANK_CYCLES);
+            break;
+        case PPUMode::HBLANK:
+            graphics.ly++;
+            if (graphics.ly == 144) {
+                setPPUMode(PPUMode::VBLANK);
+                interrupts.flags |= 0x01; // VBlank interrupt
+                windowLine = 0;
+                if (renderingFrame && frameCallback) {
+                    frameCallback(frameBuffer);
+                }
+                frameCount++;
+                beginFrame();
+                commitSaveRam(false);
+                scheduler.schedule(EVENT_PPU_MODE, timestamp + SCANLINE_CYCLES);
+            } else {
+                setPPUMode(PPUMode::OAM_SCAN);
+                scheduler.schedule(EVENT_PPU_MODE, timestamp + OAM_SCAN_CYCLES);
+            }
+            updateLCDStatus();
+            break;
+        case PPUMode::VBLANK:
+            graphics.ly++;
+            if (graphics.ly > 153) {
+                graphics.ly = 0;
+                setPPUMode(PPUMode::OAM_SCAN);
+                scheduler.schedule(EVENT_PPU_MODE, timestamp + OAM_SCAN_CYCLES);
+            } else {
+                scheduler.schedule(EVENT_PPU_MODE, timestamp + SCANLINE_CYCLES);
+            }
+            updateLCDStatus();
             break;
     }
-} 
+}
+
+// Decide whether the frame now starting is drawn. Skipped frames leave
+// the last drawn frame in frameBuffer.
+void GameBoyEmulator::beginFrame() {
+    bool wanted = frameCallback || !frameSkipRequiresCallback;
+    renderingFrame = wanted && frameCount % frameSkip == 0;
+}
+
+void GameBoyEmulator::setFrameSkip(uint32_t interval, bool requireCallback) {
+    frameSkip = std::max<uint32_t>(interval, 1);
+    frameSkipRequiresCallback = requireCallback;
+    beginFrame();
+}
+
+void GameBoyEmulator::setFrameCallback(FrameCallback callback) {
+    frameCallback = std::move(callback);
+}
+
+void GameBoyEmulator::setPPUMode(PPUMode mode) {
+    // PPUMode values match the STAT mode bits
+    ppuMode = mode;
+    graphics.stat = (graphics.stat & ~0x03) | static_cast<uint8_t>(mode);
+
+    // Mode STAT interrupt sources: bit 3 HBlank, bit 4 VBlank, bit 5 OAM scan
+    if ((mode == PPUMode::HBLANK && (graphics.stat & 0x08)) ||
+        (mode == PPUMode::VBLANK && (graphics.stat & 0x10)) ||
+        (mode == PPUMode::OAM_SCAN && (graphics.stat & 0x20))) {
+        interrupts.flags |= 0x02;
+    }
+}
@@ -0,0 +1,139 @@
+#include "InstancePool.hpp"
+#include <algorithm>
+#include <chrono>
+
+InstancePool::InstancePool(size_t threadCount)
+    : generation(0), stopping(false), pendingInstances(0), queuedJobs(0), idleWorkers(0),
+      framesPerSecond(0.0) {
+    threadCount = std::max<size_t>(threadCount, 1);
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        threads.emplace_back(&InstancePool::workerLoop, this, i);
+    }
+}
+
+InstancePool::~InstancePool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+size_t InstancePool::addInstance(std::unique_ptr<ConsoleEmulator> instance) {
+    instances.push_back(std::move(instance));
+    return instances.size() - 1;
+}
+
+void InstancePool::runFrames(uint32_t frames) {
+    if (instances.empty() || frames == 0) {
+        framesPerSecond = 0.0;
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+
+        // Count the round before any job is visible, so a worker still
+        // leaving the last round can't finish a job the count doesn't know
+        pendingInstances = instances.size();
+
+        // Deal instances out round-robin; stealing evens out the rest
+        for (size_t i = 0; i < instances.size(); i++) {
+            pushJob(i % workers.size(), {i, frames});
+        }
+        generation++;
+        workAvailable.notify_all();
+
+        workDone.wait(lock, [this] { return pendingInstances == 0; });
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    framesPerSecond = seconds > 0 ? static_cast<double>(frames) * instances.size() / seconds : 0.0;
+}
+
+void InstancePool::workerLoop(size_t index) {
+    uint64_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            workAvailable.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        // Run frames until every instance of this round has finished
+        Job job;
+        while (true) {
+            if (popJob(index, job) || stealJob(index, job)) {
+                instances[job.instance]->runUntilVBlank();
+                if (--job.framesLeft > 0) {
+                    pushJob(index, job);
+                    // Another worker may be parked with nothing to steal
+                    if (idleWorkers > 0) {
+                        std::lock_guard<std::mutex> lock(stateMutex);
+                        jobQueued.notify_one();
+                    }
+                } else if (--pendingInstances == 0) {
+                    std::lock_guard<std::mutex> lock(stateMutex);
+                    workDone.notify_all();
+                    jobQueued.notify_all();
+                }
+                continue;
+            }
+
+            // Nothing to run or steal: park until a job is re-queued or the
+            // round ends, rather than spinning on a core an SMT sibling
+            // could use
+            std::unique_lock<std::mutex> lock(stateMutex);
+            if (pendingInstances == 0) {
+                break;
+            }
+            idleWorkers++;
+            jobQueued.wait(lock, [this] { return queuedJobs > 0 || pendingInstances == 0; });
+            idleWorkers--;
+        }
+    }
+}
+
+bool InstancePool::popJob(size_t index, Job& job) {
+    Worker& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.jobs.empty()) {
+        return false;
+    }
+    job = worker.jobs.back();
+    worker.jobs.pop_back();
+    queuedJobs--;
+    return true;
+}
+
+bool InstancePool::stealJob(size_t index, Job& job) {
+    for (size_t offset = 1; offset < workers.size(); offset++) {
+        Worker& victim = *workers[(index + offset) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            queuedJobs--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void InstancePool::pushJob(size_t index, const Job& job) {
+    Worker& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.jobs.push_back(job);
+    queuedJobs++;
+}
@@ -2,11 +2,15 @@
 #include <iostream>
 
 PS1Emulator::PS1Emulator()
-    : PlayStationEmulator(ConsoleType::PS1, "Sony PlayStation", RAM_SIZE) {
+    : ConsoleCore(ConsoleType::PS1, "Sony PlayStation", RAM_SIZE, CPU_CLOCK) {
     cdrom = {};
 }
 
-bool PS1Emulator::validateROM(const std::vector<uint8_t>& data) const {
+std::unique_ptr<ConsoleEmulator> PS1Emulator::fork() {
+    return std::unique_ptr<ConsoleEmulator>(new PS1Emulator(*this));
+}
+
+bool PS1Emulator::validateROM(const RomImage& data) const {
     // Check minimum size
     if (data.size() < 0x800) {
         return false;
@@ -24,15 +28,22 @@ bool PS1Emulator::validateROM(const std::vector<uint8_t>& data) const {
     return true;
 }
 
+// One instruction per cycle until the CPU models instruction timing
+int PS1Emulator::runInstruction() {
+    executeInstruction();
+    stepSPU();
+    return 1;
+}
+
 void PS1Emulator::executeInstruction() {
     if (!cpu.pc) return;
 
     // Fetch instruction
     uint32_t instruction = 
-        (readMemory(cpu.pc) << 24) |
-        (readMemory(cpu.pc + 1) << 16) |
-        (readMemory(cpu.pc + 2) << 8) |
-        readMemory(cpu.pc + 3);
+        (busRead(cpu.pc) << 24) |
+        (busRead(cpu.pc + 1) << 16) |
+        (busRead(cpu.pc + 2) << 8) |
+        busRead(cpu.pc + 3);
     
     cpu.pc += 4;
 
@@ -132,4 +143,6 @@ void PS1Emulator::updateSPUStatus() {
         }
         spu->write((SPU_STATUS_START - SPU_START) / 2, status);
     }
-} 
+}
+
+template class ConsoleCore<PS1Emulator, PlayStationEmulator>;
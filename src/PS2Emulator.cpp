@@ -2,14 +2,19 @@
 #include <iostream>
 
 PS2Emulator::PS2Emulator()
-    : PlayStationEmulator(ConsoleType::PS2, "Sony PlayStation 2", RAM_SIZE) {
+    : ConsoleCore(ConsoleType::PS2, "Sony PlayStation 2", RAM_SIZE, CPU_CLOCK) {
     ee = {};
-    gs = {};
+    gs.status = 0;
+    gs.control = 0;
     iop = {};
-    gs.local_mem.resize(4 * 1024 * 1024, 0); // 4MB GS memory
+    gs.local_mem.assign(4 * 1024 * 1024, 0); // 4MB GS memory
 }
 
-bool PS2Emulator::validateROM(const std::vector<uint8_t>& data) const {
+std::unique_ptr<ConsoleEmulator> PS2Emulator::fork() {
+    return std::unique_ptr<ConsoleEmulator>(new PS2Emulator(*this));
+}
+
+bool PS2Emulator::validateROM(const RomImage& data) const {
     // Check minimum size
     if (data.size() < 0x800) {
         return false;
@@ -27,6 +32,13 @@ bool PS2Emulator::validateROM(const std::vector<uint8_t>& data) const {
     return true;
 }
 
+// One instruction per cycle until the CPU models instruction timing
+int PS2Emulator::runInstruction() {
+    executeInstruction();
+    stepSPU();
+    return 1;
+}
+
 void PS2Emulator::executeInstruction() {
     // Execute one instruction on each processor
     executeEEInstruction();
@@ -40,14 +52,14 @@ void PS2Emulator::executeEEInstruction() {
 
     // Fetch instruction from EE memory
     uint64_t instruction = 
-        (static_cast<uint64_t>(readMemory(ee.pc)) << 56) |
-        (static_cast<uint64_t>(readMemory(ee.pc + 1)) << 48) |
-        (static_cast<uint64_t>(readMemory(ee.pc + 2)) << 40) |
-        (static_cast<uint64_t>(readMemory(ee.pc + 3)) << 32) |
-        (static_cast<uint64_t>(readMemory(ee.pc + 4)) << 24) |
-        (static_cast<uint64_t>(readMemory(ee.pc + 5)) << 16) |
-        (static_cast<uint64_t>(readMemory(ee.pc + 6)) << 8) |
-        static_cast<uint64_t>(readMemory(ee.pc + 7));
+        (static_cast<uint64_t>(busRead(ee.pc)) << 56) |
+        (static_cast<uint64_t>(busRead(ee.pc + 1)) << 48) |
+        (static_cast<uint64_t>(busRead(ee.pc + 2)) << 40) |
+        (static_cast<uint64_t>(busRead(ee.pc + 3)) << 32) |
+        (static_cast<uint64_t>(busRead(ee.pc + 4)) << 24) |
+        (static_cast<uint64_t>(busRead(ee.pc + 5)) << 16) |
+        (static_cast<uint64_t>(busRead(ee.pc + 6)) << 8) |
+        static_cast<uint64_t>(busRead(ee.pc + 7));
 
     ee.pc += 8;
 
@@ -83,10 +95,10 @@ void PS2Emulator::executeIOPInstruction() {
 
     // Fetch instruction from IOP memory
     uint32_t instruction = 
-        (readMemory(iop.pc) << 24) |
-        (readMemory(iop.pc + 1) << 16) |
-        (readMemory(iop.pc + 2) << 8) |
-        readMemory(iop.pc + 3);
+        (busRead(iop.pc) << 24) |
+        (busRead(iop.pc + 1) << 16) |
+        (busRead(iop.pc + 2) << 8) |
+        busRead(iop.pc + 3);
 
     iop.pc += 4;
 
@@ -208,4 +220,6 @@ void PS2Emulator::mixSPU2Output() {
     
     // Clear the audio buffer after processing to prepare for next frame
     spu->clearAudioBuffer();
-} 
+}
+
+template class ConsoleCore<PS2Emulator, PlayStationEmulator>;
@@ -0,0 +1,162 @@
+#include "PixelKernels.hpp"
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+#define PIXEL_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+void PixelKernels::decode2bppScalar(const uint8_t* planes, size_t pairs, uint8_t* out) {
+    for (size_t row = 0; row < pairs; row++) {
+        uint8_t low = planes[row * 2];
+        uint8_t high = planes[row * 2 + 1];
+        for (int x = 0; x < 8; x++) {
+            int bit = 7 - x;
+            out[row * 8 + x] = static_cast<uint8_t>((((high >> bit) & 1) << 1) | ((low >> bit) & 1));
+        }
+    }
+}
+
+void PixelKernels::applyPaletteScalar(const uint8_t* indices, size_t count, uint8_t palette, uint8_t* out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = (palette >> (indices[i] * 2)) & 0x03;
+    }
+}
+
+#ifdef PIXEL_KERNELS_X86
+namespace {
+
+// SSE2: eight bitplane pairs at a time. The low and high planes are split
+// into two 8-byte halves, each plane byte is repeated across the eight
+// lanes of its row, and every lane tests its own bit (0x80 for the
+// leftmost pixel) with AND + compare.
+void decode2bppSSE2(const uint8_t* planes, size_t pairs, uint8_t* out) {
+    const __m128i bits = _mm_set_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i two = _mm_set1_epi8(2);
+
+    size_t row = 0;
+    for (; row + 8 <= pairs; row += 8) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes + row * 2));
+        __m128i low = _mm_and_si128(data, _mm_set1_epi16(0x00FF));
+        __m128i high = _mm_srli_epi16(data, 8);
+        __m128i split = _mm_packus_epi16(low, high);      // L0..L7 H0..H7
+
+        __m128i lows = _mm_unpacklo_epi8(split, split);   // L0 L0 L1 L1 ...
+        __m128i highs = _mm_unpackhi_epi8(split, split);
+        __m128i lowQuads[2] = {_mm_unpacklo_epi16(lows, lows), _mm_unpackhi_epi16(lows, lows)};
+        __m128i highQuads[2] = {_mm_unpacklo_epi16(highs, highs), _mm_unpackhi_epi16(highs, highs)};
+
+        for (int half = 0; half < 2; half++) {
+            // Rows 4*half+0/1, then 4*half+2/3
+            __m128i lowRows[2] = {_mm_unpacklo_epi32(lowQuads[half], lowQuads[half]),
+                                  _mm_unpackhi_epi32(lowQuads[half], lowQuads[half])};
+            __m128i highRows[2] = {_mm_unpacklo_epi32(highQuads[half], highQuads[half]),
+                                   _mm_unpackhi_epi32(highQuads[half], highQuads[half])};
+            for (int pair = 0; pair < 2; pair++) {
+                __m128i l = _mm_cmpeq_epi8(_mm_and_si128(lowRows[pair], bits), bits);
+                __m128i h = _mm_cmpeq_epi8(_mm_and_si128(highRows[pair], bits), bits);
+                __m128i pixels = _mm_or_si128(_mm_and_si128(l, one), _mm_and_si128(h, two));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + (row + half * 4 + pair * 2) * 8), pixels);
+            }
+        }
+    }
+    PixelKernels::decode2bppScalar(planes + row * 2, pairs - row, out + row * 8);
+}
+
+// SSE2 has no byte shuffle, so each of the four colors is selected by a
+// compare against its index
+void applyPaletteSSE2(const uint8_t* indices, size_t count, uint8_t palette, uint8_t* out) {
+    __m128i colors[4];
+    for (int i = 0; i < 4; i++) {
+        colors[i] = _mm_set1_epi8(static_cast<char>((palette >> (i * 2)) & 0x03));
+    }
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+        __m128i result = _mm_setzero_si128();
+        for (int color = 0; color < 4; color++) {
+            __m128i match = _mm_cmpeq_epi8(index, _mm_set1_epi8(static_cast<char>(color)));
+            result = _mm_or_si128(result, _mm_and_si128(match, colors[color]));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), result);
+    }
+    PixelKernels::applyPaletteScalar(indices + i, count - i, palette, out + i);
+}
+
+// One row with BMI2: PDEP scatters the eight plane bits into the low bit
+// (or second bit) of eight bytes, lowest bit first; the byte swap puts
+// the leftmost pixel (bit 7) in the first byte.
+__attribute__((target("bmi2")))
+inline uint64_t decodeRowPDEP(uint8_t low, uint8_t high) {
+    uint64_t pixels = _pdep_u64(low, 0x0101010101010101ull) | _pdep_u64(high, 0x0202020202020202ull);
+    return __builtin_bswap64(pixels);
+}
+
+// AVX2: four rows per 256-bit vector, the plane bytes repeated across
+// their rows' lanes with one in-lane byte shuffle each
+__attribute__((target("avx2,bmi2")))
+void decode2bppAVX2(const uint8_t* planes, size_t pairs, uint8_t* out) {
+    const __m256i bits = _mm256_set1_epi64x(0x0102040810204080ll);
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i two = _mm256_set1_epi8(2);
+    // Even plane bytes are the low planes: row r's low byte is at 2r
+    const __m256i lowIndex[2] = {
+        _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 2, 2, 2, 2,
+                         4, 4, 4, 4, 4, 4, 4, 4, 6, 6, 6, 6, 6, 6, 6, 6),
+        _mm256_setr_epi8(8, 8, 8, 8, 8, 8, 8, 8, 10, 10, 10, 10, 10, 10, 10, 10,
+                         12, 12, 12, 12, 12, 12, 12, 12, 14, 14, 14, 14, 14, 14, 14, 14)};
+    const __m256i highIndex[2] = {_mm256_add_epi8(lowIndex[0], one), _mm256_add_epi8(lowIndex[1], one)};
+
+    size_t row = 0;
+    for (; row + 8 <= pairs; row += 8) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes + row * 2));
+        __m256i both = _mm256_broadcastsi128_si256(data);
+        for (int half = 0; half < 2; half++) {
+            __m256i low = _mm256_shuffle_epi8(both, lowIndex[half]);
+            __m256i high = _mm256_shuffle_epi8(both, highIndex[half]);
+            __m256i l = _mm256_cmpeq_epi8(_mm256_and_si256(low, bits), bits);
+            __m256i h = _mm256_cmpeq_epi8(_mm256_and_si256(high, bits), bits);
+            __m256i pixels = _mm256_or_si256(_mm256_and_si256(l, one), _mm256_and_si256(h, two));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + (row + half * 4) * 8), pixels);
+        }
+    }
+    for (; row < pairs; row++) {
+        uint64_t pixels = decodeRowPDEP(planes[row * 2], planes[row * 2 + 1]);
+        std::memcpy(out + row * 8, &pixels, sizeof(pixels));
+    }
+}
+
+// The four colors form a byte lookup table for VPSHUFB
+__attribute__((target("avx2")))
+void applyPaletteAVX2(const uint8_t* indices, size_t count, uint8_t palette, uint8_t* out) {
+    __m256i table = _mm256_setr_epi8(
+        palette & 3, (palette >> 2) & 3, (palette >> 4) & 3, (palette >> 6) & 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        palette & 3, (palette >> 2) & 3, (palette >> 4) & 3, (palette >> 6) & 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(table, index));
+    }
+    applyPaletteSSE2(indices + i, count - i, palette, out + i);
+}
+
+} // namespace
+#endif
+
+const PixelKernels::Table& PixelKernels::kernels() {
+    static const Table table = [] {
+#ifdef PIXEL_KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2")) {
+            return Table{decode2bppAVX2, applyPaletteAVX2, "avx2"};
+        }
+        return Table{decode2bppSSE2, applyPaletteSSE2, "sse2"};
+#else
+        return Table{decode2bppScalar, applyPaletteScalar, "scalar"};
+#endif
+    }();
+    return table;
+}
@@ -3,20 +3,34 @@
 #include <iostream>
 #include <algorithm>
 
-PlayStationEmulator::PlayStationEmulator(ConsoleType type, const std::string& name, uint32_t ramSize)
-    : consoleType(type), consoleName(name), ramSize(ramSize) {
+PlayStationEmulator::PlayStationEmulator(ConsoleType type, const std::string& name, uint32_t ramSize, uint32_t cpuClock)
+    : cycleCount(0), spuWord(0), consoleType(type), consoleName(name), ramSize(ramSize), cyclesPerFrame(cpuClock / 60) {
     reset();
 }
 
+PlayStationEmulator::PlayStationEmulator(const PlayStationEmulator& other)
+    : ConsoleEmulator(other),
+      cycleCount(other.cycleCount),
+      ram(other.ram),
+      vram(other.vram),
+      biosRom(other.biosRom),
+      gameRom(other.gameRom),
+      cpu(other.cpu),
+      gpu(other.gpu),
+      spu(other.spu ? std::make_unique<SPU>(*other.spu) : nullptr),
+      spuWord(other.spuWord),
+      consoleType(other.consoleType),
+      consoleName(other.consoleName),
+      ramSize(other.ramSize),
+      cyclesPerFrame(other.cyclesPerFrame) {
+}
+
 bool PlayStationEmulator::initialize() {
     reset();
     return true;
 }
 
-void PlayStationEmulator::step() {
-    executeInstruction();
-    
-    // Step the SPU
+void PlayStationEmulator::stepSPU() {
     if (spu) {
         spu->step();
     }
@@ -29,30 +43,30 @@ void PlayStationEmulator::reset() {
     initializeSPU();
 }
 
-bool PlayStationEmulator::loadROM(const std::vector<uint8_t>& data) {
-    if (!validateROM(data)) {
+bool PlayStationEmulator::loadROM(std::shared_ptr<const RomImage> image) {
+    if (!image || !validateROM(*image)) {
         return false;
     }
 
-    gameRom = data;
+    gameRom = std::move(image);
     return true;
 }
 
-uint8_t PlayStationEmulator::readMemory(uint32_t address) const {
+uint8_t PlayStationEmulator::readMemorySlow(uint32_t address) const {
     // Basic memory map implementation
     if (address < ram.size()) {
-        return ram[address];
+        return ram.read(address);
     }
     else if (address >= 0x1F000000 && address < 0x1F800000) {
         // BIOS ROM
         uint32_t biosAddr = address - 0x1F000000;
         if (biosAddr < biosRom.size()) {
-            return biosRom[biosAddr];
+            return biosRom.read(biosAddr);
         }
     }
     else if (address >= 0x80000000 && address < 0x80000000 + ram.size()) {
         // Mirror of RAM in kernel space
-        return ram[address - 0x80000000];
+        return ram.read(address - 0x80000000);
     }
     else if (address >= 0x1F801C00 && address < 0x1F802000) {
         // SPU registers
@@ -65,19 +79,18 @@ uint8_t PlayStationEmulator::readMemory(uint32_t address) const {
     return 0;
 }
 
-void PlayStationEmulator::writeMemory(uint32_t address, uint8_t value) {
+void PlayStationEmulator::writeMemorySlow(uint32_t address, uint8_t value) {
     // Basic memory map implementation
     if (address < ram.size()) {
-        ram[address] = value;
+        ram.write(address, value);
     }
     else if (address >= 0x80000000 && address < 0x80000000 + ram.size()) {
         // Mirror of RAM in kernel space
-        ram[address - 0x80000000] = value;
+        ram.write(address - 0x80000000, value);
     }
     else if (address >= 0x1F801C00 && address < 0x1F802000) {
         // SPU registers
         if (spu) {
-            static uint16_t spuWord = 0;
             if (address & 1) {
                 spuWord = (spuWord & 0xFF) | (value << 8);
                 spu->write((address - 0x1F801C00) / 2, spuWord);
@@ -98,7 +111,9 @@ bool PlayStationEmulator::saveState(const std::string& filepath) {
     }
 
     // Save RAM
-    file.write(reinterpret_cast<const char*>(ram.data()), ram.size());
+    std::vector<uint8_t> snapshot(ram.size());
+    ram.copyTo(snapshot.data());
+    file.write(reinterpret_cast<const char*>(snapshot.data()), snapshot.size());
     
     // Save CPU state
     file.write(reinterpret_cast<const char*>(&cpu), sizeof(cpu));
@@ -124,7 +139,9 @@ bool PlayStationEmulator::loadState(const std::string& filepath) {
     }
 
     // Load RAM
-    file.read(reinterpret_cast<char*>(ram.data()), ram.size());
+    std::vector<uint8_t> snapshot(ram.size());
+    file.read(reinterpret_cast<char*>(snapshot.data()), snapshot.size());
+    ram.copyFrom(snapshot.data());
     
     // Load CPU state
     file.read(reinterpret_cast<char*>(&cpu), sizeof(cpu));
@@ -143,7 +160,7 @@ bool PlayStationEmulator::loadState(const std::string& filepath) {
     return true;
 }
 
-bool PlayStationEmulator::validateROM(const std::vector<uint8_t>& data) const {
+bool PlayStationEmulator::validateROM(const RomImage& data) const {
     // Basic size check
     if (data.size() < 0x800) {
         return false;
@@ -153,14 +170,14 @@ bool PlayStationEmulator::validateROM(const std::vector<uint8_t>& data) const {
     return (data[0] == 'P' && data[1] == 'S' && data[2] == 'X' && data[3] == ' ');
 }
 
-bool PlayStationEmulator::detectConsoleType(const std::vector<uint8_t>& data) const {
+bool PlayStationEmulator::detectConsoleType(const RomImage& data) const {
     return validateROM(data);
 }
 
 void PlayStationEmulator::initializeMemory() {
-    ram.resize(ramSize, 0);
-    vram.resize(1024 * 1024, 0);  // 1MB VRAM
-    biosRom.resize(512 * 1024, 0); // 512KB BIOS
+    ram.assign(ramSize, 0);
+    vram.assign(1024 * 1024, 0);  // 1MB VRAM
+    biosRom.assign(512 * 1024, 0); // 512KB BIOS
 }
 
 void PlayStationEmulator::initializeCPU() {
@@ -170,7 +187,6 @@ void PlayStationEmulator::initializeCPU() {
 
 void PlayStationEmulator::initializeGPU() {
     gpu = {};  // Zero initialize
-    gpu.vram.resize(1024 * 1024, 0);  // 1MB VRAM
 }
 
 void PlayStationEmulator::initializeSPU() {
@@ -178,4 +194,5 @@ void PlayStationEmulator::initializeSPU() {
     bool isPS2 = (consoleType == ConsoleType::PS2);
     spu = std::make_unique<SPU>(isPS2);
     spu->initialize();
+    spuWord = 0;
 } 
@@ -0,0 +1,98 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+Profiler::Profiler() {
+    clear();
+}
+
+void Profiler::clear() {
+    entries.assign(0x10000, Entry{0, 0});
+    banks.clear();
+    totalCycles = 0;
+    haltCycles = 0;
+}
+
+std::vector<Profiler::HotSpot> Profiler::getHotSpots(size_t limit) const {
+    std::vector<HotSpot> spots;
+    auto collect = [&spots](uint16_t bank, uint16_t address, const Entry& entry) {
+        if (entry.count) {
+            spots.push_back({bank, address, entry.count, entry.cycles});
+        }
+    };
+    for (size_t address = 0; address < entries.size(); address++) {
+        collect(0, static_cast<uint16_t>(address), entries[address]);
+    }
+    for (size_t bank = 0; bank < banks.size(); bank++) {
+        if (!banks[bank]) {
+            continue;
+        }
+        for (size_t offset = 0; offset < WINDOW_SIZE; offset++) {
+            collect(static_cast<uint16_t>(bank), static_cast<uint16_t>(WINDOW_START + offset), (*banks[bank])[offset]);
+        }
+    }
+
+    limit = std::min(limit, spots.size());
+    std::partial_sort(spots.begin(), spots.begin() + limit, spots.end(),
+                      [](const HotSpot& a, const HotSpot& b) { return a.cycles > b.cycles; });
+    spots.resize(limit);
+    return spots;
+}
+
+std::string Profiler::report(size_t limit, const std::function<std::string(const HotSpot&)>& disassemble) const {
+    std::ostringstream ss;
+    uint64_t total = totalCycles + haltCycles;
+    ss << "Total cycles: " << total << " (halted " << haltCycles << ")\n";
+    ss << " bank:addr      count         cycles       %  instruction\n";
+    for (const HotSpot& spot : getHotSpots(limit)) {
+        double share = total ? 100.0 * spot.cycles / total : 0.0;
+        ss << std::hex << std::uppercase << std::setfill('0')
+           << ' ' << std::setw(4) << spot.bank << ':' << std::setw(4) << spot.address
+           << std::dec << std::setfill(' ')
+           << std::setw(11) << spot.count
+           << std::setw(15) << spot.cycles
+           << std::fixed << std::setprecision(2) << std::setw(8) << share << "  "
+           << (disassemble ? disassemble(spot) : std::string()) << '\n';
+    }
+    return ss.str();
+}
+
+std::vector<uint64_t> Profiler::getHeatmap() const {
+    std::vector<uint64_t> heatmap(0x10000, 0);
+    for (size_t address = 0; address < entries.size(); address++) {
+        heatmap[address] += entries[address].cycles;
+    }
+    for (const std::unique_ptr<Bank>& bank : banks) {
+        if (!bank) {
+            continue;
+        }
+        for (size_t offset = 0; offset < WINDOW_SIZE; offset++) {
+            heatmap[WINDOW_START + offset] += (*bank)[offset].cycles;
+        }
+    }
+    return heatmap;
+}
+
+bool Profiler::writeHeatmap(const std::string& filepath) const {
+    std::FILE* file = std::fopen(filepath.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    std::vector<uint64_t> heatmap = getHeatmap();
+    uint64_t peak = *std::max_element(heatmap.begin(), heatmap.end());
+    double scale = peak ? 255.0 / std::log1p(static_cast<double>(peak)) : 0.0;
+
+    std::vector<uint8_t> pixels(heatmap.size());
+    for (size_t i = 0; i < heatmap.size(); i++) {
+        pixels[i] = static_cast<uint8_t>(std::lround(std::log1p(static_cast<double>(heatmap[i])) * scale));
+    }
+
+    std::fprintf(file, "P5\n256 256\n255\n");
+    bool ok = std::fwrite(pixels.data(), 1, pixels.size(), file) == pixels.size();
+    std::fclose(file);
+    return ok;
+}
@@ -0,0 +1,176 @@
+#include "Recompiler.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define RECOMPILER_SUPPORTED 1
+#else
+#define RECOMPILER_SUPPORTED 0
+#endif
+
+// Worst case per instruction is a handler call with both early-exit checks
+static constexpr size_t MAX_INSTRUCTION_BYTES = 64;
+static constexpr size_t MAX_FRAME_BYTES = 64;
+
+bool Recompiler::isSupported() {
+    return RECOMPILER_SUPPORTED;
+}
+
+Recompiler::Recompiler(const Context& context)
+    : context(context), code(nullptr), used(0) {
+#if RECOMPILER_SUPPORTED
+    void* memory = mmap(nullptr, CODE_CACHE_SIZE, PROT_READ | PROT_EXEC,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory != MAP_FAILED) {
+        code = static_cast<uint8_t*>(memory);
+    }
+#endif
+}
+
+Recompiler::~Recompiler() {
+#if RECOMPILER_SUPPORTED
+    if (code) {
+        munmap(code, CODE_CACHE_SIZE);
+    }
+#endif
+}
+
+void Recompiler::reset() {
+    used = 0;
+}
+
+// Register layout while a block runs:
+//   rbx = &pc, r12 = &cycleCount, r13 = instructions executed,
+//   r14 = &breakBlock, r15 = emulator passed to handlers, rbp = &deadline
+BlockCache::NativeCode Recompiler::compile(const BlockCache::Block& block) {
+#if RECOMPILER_SUPPORTED
+    if (!code || used + MAX_FRAME_BYTES + block.instructions.size() * MAX_INSTRUCTION_BYTES > CODE_CACHE_SIZE) {
+        return nullptr;
+    }
+
+    buffer.clear();
+    std::vector<size_t> exitJumps;
+    auto emitExitJump = [&]() {
+        exitJumps.push_back(buffer.size());
+        emit32(0);
+    };
+
+    // Prologue: six pushes and the padding keep the stack 16-byte aligned
+    emit({0x55, 0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57});  // push rbp, rbx, r12-r15
+    emit({0x48, 0x83, 0xEC, 0x08});                               // sub rsp, 8
+    emit({0x48, 0xBB}); emitPointer(context.pc);                  // mov rbx, &pc
+    emit({0x49, 0xBC}); emitPointer(context.cycleCount);          // mov r12, &cycleCount
+    emit({0x49, 0xBE}); emitPointer(context.breakBlock);          // mov r14, &breakBlock
+    emit({0x49, 0xBF}); emitPointer(context.cpu);                 // mov r15, cpu
+    emit({0x48, 0xBD}); emitPointer(context.deadline);            // mov rbp, &deadline
+    emit({0x45, 0x31, 0xED});                                     // xor r13d, r13d
+
+    for (size_t i = 0; i < block.instructions.size(); i++) {
+        const BlockCache::Instruction& instruction = block.instructions[i];
+
+        // Stop at the next hardware event, as the interpreter would. The
+        // caller only enters a block before it.
+        if (i > 0) {
+            emit({0x49, 0x8B, 0x04, 0x24});                       // mov rax, [r12]
+            emit({0x48, 0x3B, 0x45, 0x00});                       // cmp rax, [rbp]
+            emit({0x0F, 0x83});                                   // jae exit
+            emitExitJump();
+        }
+
+        // Handlers see PC past their own instruction, as in the interpreter
+        emit({0x49, 0xFF, 0xC5});                                 // inc r13
+        emit({0x66, 0x81, 0x03, static_cast<uint8_t>(instruction.length), 0x00});  // add word [rbx], length
+        if (emitInline(instruction)) {
+            continue;
+        }
+
+        emit({0x4C, 0x89, 0xFF});                                 // mov rdi, r15
+        emit({0xBE}); emit32(instruction.operand);                // mov esi, operand
+        emit({0x48, 0xB8}); emitPointer(reinterpret_cast<const void*>(instruction.handler));  // mov rax, handler
+        emit({0xFF, 0xD0});                                       // call rax
+        emit({0x89, 0xC0});                                       // mov eax, eax
+        emit({0x49, 0x01, 0x04, 0x24});                           // add [r12], rax
+
+        if (i + 1 < block.instructions.size()) {
+            emit({0x41, 0x80, 0x3E, 0x00});                       // cmp byte [r14], 0
+            emit({0x0F, 0x85});                                   // jne exit
+            emitExitJump();
+        }
+    }
+
+    // Epilogue: publish the instruction count
+    size_t exitOffset = buffer.size();
+    for (size_t jump : exitJumps) {
+        uint32_t displacement = static_cast<uint32_t>(exitOffset - (jump + 4));
+        std::memcpy(&buffer[jump], &displacement, sizeof(displacement));
+    }
+    emit({0x48, 0xB8}); emitPointer(context.instructionCount);    // mov rax, &instructionCount
+    emit({0x4C, 0x01, 0x28});                                     // add [rax], r13
+    emit({0x48, 0x83, 0xC4, 0x08});                               // add rsp, 8
+    emit({0x41, 0x5F, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0x5D});  // pop r15-r12, rbx, rbp
+    emit({0xC3});                                                 // ret
+
+    // Keep the cache W^X: only the pages the new block lands on are made
+    // writable, and only while it is copied in
+    static const size_t PAGE_SIZE_BYTES = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    uint8_t* entry = code + used;
+    size_t first = used & ~(PAGE_SIZE_BYTES - 1);
+    size_t end = (used + buffer.size() + PAGE_SIZE_BYTES - 1) & ~(PAGE_SIZE_BYTES - 1);
+    if (mprotect(code + first, end - first, PROT_READ | PROT_WRITE) != 0) {
+        return nullptr;
+    }
+    std::memcpy(entry, buffer.data(), buffer.size());
+    mprotect(code + first, end - first, PROT_READ | PROT_EXEC);
+    used += (buffer.size() + 15) & ~size_t(15);
+
+    return reinterpret_cast<BlockCache::NativeCode>(entry);
+#else
+    (void)block;
+    return nullptr;
+#endif
+}
+
+// Register-only loads that need no handler call
+bool Recompiler::emitInline(const BlockCache::Instruction& instruction) {
+    uint8_t opcode = instruction.opcode;
+    uint8_t dst = (opcode >> 3) & 7;
+    uint8_t src = opcode & 7;
+
+    if (opcode == 0x00) {                                         // NOP
+        emit({0x49, 0x83, 0x04, 0x24, 4});                        // add qword [r12], 4
+        return true;
+    }
+    if ((opcode & 0xC0) == 0x40 && dst != 6 && src != 6) {        // LD r,r'
+        emit({0x8A, 0x43, static_cast<uint8_t>(registerOffset(src))});  // mov al, [rbx+src]
+        emit({0x88, 0x43, static_cast<uint8_t>(registerOffset(dst))});  // mov [rbx+dst], al
+        emit({0x49, 0x83, 0x04, 0x24, 4});
+        return true;
+    }
+    if ((opcode & 0xC7) == 0x06 && dst != 6) {                    // LD r,n
+        emit({0xC6, 0x43, static_cast<uint8_t>(registerOffset(dst)), static_cast<uint8_t>(instruction.operand)});
+        emit({0x49, 0x83, 0x04, 0x24, 8});
+        return true;
+    }
+    return false;
+}
+
+int8_t Recompiler::registerOffset(int index) const {
+    return static_cast<int8_t>(context.registers[index] - reinterpret_cast<uint8_t*>(context.pc));
+}
+
+void Recompiler::emit(std::initializer_list<uint8_t> bytes) {
+    buffer.insert(buffer.end(), bytes);
+}
+
+void Recompiler::emit32(uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+void Recompiler::emit64(uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
@@ -0,0 +1,85 @@
+#include "RomImage.hpp"
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ROMIMAGE_HAVE_MMAP 1
+#endif
+
+namespace {
+
+// Images by path, so instances loading the same file share one mapping
+std::mutex cacheMutex;
+std::unordered_map<std::string, std::weak_ptr<const RomImage>> cache;
+
+} // namespace
+
+std::shared_ptr<const RomImage> RomImage::open(const std::string& filepath) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto cached = cache.find(filepath);
+    if (cached != cache.end()) {
+        if (auto image = cached->second.lock()) {
+            return image;
+        }
+    }
+
+    std::shared_ptr<RomImage> image(new RomImage());
+
+#ifdef ROMIMAGE_HAVE_MMAP
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    image->length = static_cast<size_t>(info.st_size);
+    if (image->length > 0) {
+        void* address = mmap(nullptr, image->length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            return nullptr;
+        }
+        image->bytes = static_cast<const uint8_t*>(address);
+        image->mapped = true;
+    }
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+#else
+    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return nullptr;
+    }
+    image->buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char*>(image->buffer.data()), image->buffer.size());
+    image->bytes = image->buffer.data();
+    image->length = image->buffer.size();
+#endif
+
+    cache[filepath] = image;
+    return image;
+}
+
+std::shared_ptr<const RomImage> RomImage::fromBuffer(std::vector<uint8_t> data) {
+    std::shared_ptr<RomImage> image(new RomImage());
+    image->buffer = std::move(data);
+    image->bytes = image->buffer.data();
+    image->length = image->buffer.size();
+    return image;
+}
+
+RomImage::~RomImage() {
+#ifdef ROMIMAGE_HAVE_MMAP
+    if (mapped) {
+        munmap(const_cast<uint8_t*>(bytes), length);
+    }
+#endif
+}
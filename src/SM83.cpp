@@ -0,0 +1,599 @@
+#include "SM83.hpp"
+#include "GameBoyEmulator.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <utility>
+
+// Operand patterns follow the usual x/y/z decomposition of the opcode byte:
+//   x = bits 7-6, y = bits 5-3, z = bits 2-0, p = y >> 1, q = y & 1
+// r[]   : B C D E H L (HL) A
+// rp[]  : BC DE HL SP
+// rp2[] : BC DE HL AF
+// cc[]  : NZ Z NC C
+struct SM83::Ops {
+    using Regs = GameBoyEmulator::Registers;
+
+    // 8-bit operand r[Index]; index 6 is the byte at (HL)
+    template <uint8_t Index>
+    struct R8 {
+        static constexpr int cycles = Index == 6 ? 4 : 0;
+
+        static uint8_t& reg(Regs& r) {
+            if constexpr (Index == 0) return r.b;
+            else if constexpr (Index == 1) return r.c;
+            else if constexpr (Index == 2) return r.d;
+            else if constexpr (Index == 3) return r.e;
+            else if constexpr (Index == 4) return r.h;
+            else if constexpr (Index == 5) return r.l;
+            else return r.a;
+        }
+        static uint8_t read(GameBoyEmulator& gb) {
+            if constexpr (Index == 6) return gb.busRead(gb.registers.hl);
+            else return reg(gb.registers);
+        }
+        static void write(GameBoyEmulator& gb, uint8_t value) {
+            if constexpr (Index == 6) gb.busWrite(gb.registers.hl, value);
+            else reg(gb.registers) = value;
+        }
+    };
+
+    // 16-bit operand rp[Index]
+    template <uint8_t Index>
+    struct R16 {
+        static uint16_t& reg(Regs& r) {
+            if constexpr (Index == 0) return r.bc;
+            else if constexpr (Index == 1) return r.de;
+            else if constexpr (Index == 2) return r.hl;
+            else return r.sp;
+        }
+    };
+
+    // 16-bit operand rp2[Index] used by PUSH/POP
+    template <uint8_t Index>
+    struct R16Stack {
+        static uint16_t read(GameBoyEmulator& gb) {
+            if constexpr (Index == 3) return gb.getAF();
+            else return R16<Index>::reg(gb.registers);
+        }
+        static void write(GameBoyEmulator& gb, uint16_t value) {
+            if constexpr (Index == 3) gb.setAF(value);
+            else R16<Index>::reg(gb.registers) = value;
+        }
+    };
+
+    // Branch condition cc[Index]
+    template <uint8_t Index>
+    struct Cond {
+        static bool test(const GameBoyEmulator& gb) {
+            if constexpr (Index == 0) return !gb.getZeroFlag();
+            else if constexpr (Index == 1) return gb.getZeroFlag();
+            else if constexpr (Index == 2) return !gb.getCarryFlag();
+            else return gb.getCarryFlag();
+        }
+    };
+
+    // Always-true condition for the unconditional JR/JP/CALL/RET forms
+    struct Always {
+        static bool test(const GameBoyEmulator&) { return true; }
+    };
+
+    // Misc / control
+    static int nop(GameBoyEmulator&, uint16_t) { return 4; }
+
+    static int unknown(GameBoyEmulator& gb, uint16_t) {
+        // The real CPU locks up; we count it and carry on so a bad jump
+        // shows up in the statistics instead of flooding the console.
+        gb.unknownOpcodeCount++;
+        return 4;
+    }
+
+    static int stop(GameBoyEmulator& gb, uint16_t) {
+        gb.stopped = true;
+        return 4;
+    }
+
+    static int halt(GameBoyEmulator& gb, uint16_t) {
+        gb.halted = true;
+        return 4;
+    }
+
+    static int di(GameBoyEmulator& gb, uint16_t) {
+        gb.interrupts.master = false;
+        gb.interrupts.enablePending = false;
+        return 4;
+    }
+
+    static int ei(GameBoyEmulator& gb, uint16_t) {
+        gb.interrupts.enablePending = true;
+        return 4;
+    }
+
+    static int cbPrefix(GameBoyEmulator& gb, uint16_t operand) {
+        return cbOpcodeTable[operand & 0xFF](gb, 0);
+    }
+
+    // 8-bit loads
+    template <class Dst, class Src>
+    static int ld(GameBoyEmulator& gb, uint16_t) {
+        Dst::write(gb, Src::read(gb));
+        return 4 + Dst::cycles + Src::cycles;
+    }
+
+    template <class Dst>
+    static int ldImm(GameBoyEmulator& gb, uint16_t operand) {
+        Dst::write(gb, static_cast<uint8_t>(operand));
+        return 8 + Dst::cycles;
+    }
+
+    // LD (BC),A / LD (DE),A / LD (HL+),A / LD (HL-),A and the reverse forms
+    template <uint8_t P>
+    static uint16_t indirectAddress(GameBoyEmulator& gb) {
+        auto& r = gb.registers;
+        if constexpr (P == 0) return r.bc;
+        else if constexpr (P == 1) return r.de;
+        else if constexpr (P == 2) return r.hl++;
+        else return r.hl--;
+    }
+
+    template <uint8_t P>
+    static int ldIndirectA(GameBoyEmulator& gb, uint16_t) {
+        gb.busWrite(indirectAddress<P>(gb), gb.registers.a);
+        return 8;
+    }
+
+    template <uint8_t P>
+    static int ldAIndirect(GameBoyEmulator& gb, uint16_t) {
+        gb.registers.a = gb.busRead(indirectAddress<P>(gb));
+        return 8;
+    }
+
+    static int ldhNA(GameBoyEmulator& gb, uint16_t operand) {
+        gb.busWrite(0xFF00 | (operand & 0xFF), gb.registers.a);
+        return 12;
+    }
+
+    static int ldhAN(GameBoyEmulator& gb, uint16_t operand) {
+        gb.registers.a = gb.busRead(0xFF00 | (operand & 0xFF));
+        return 12;
+    }
+
+    static int ldhCA(GameBoyEmulator& gb, uint16_t) {
+        gb.busWrite(0xFF00 | gb.registers.c, gb.registers.a);
+        return 8;
+    }
+
+    static int ldhAC(GameBoyEmulator& gb, uint16_t) {
+        gb.registers.a = gb.busRead(0xFF00 | gb.registers.c);
+        return 8;
+    }
+
+    static int ldNNA(GameBoyEmulator& gb, uint16_t operand) {
+        gb.busWrite(operand, gb.registers.a);
+        return 16;
+    }
+
+    static int ldANN(GameBoyEmulator& gb, uint16_t operand) {
+        gb.registers.a = gb.busRead(operand);
+        return 16;
+    }
+
+    // 16-bit loads and arithmetic
+    template <uint8_t P>
+    static int ld16(GameBoyEmulator& gb, uint16_t operand) {
+        R16<P>::reg(gb.registers) = operand;
+        return 12;
+    }
+
+    static int ldNNSP(GameBoyEmulator& gb, uint16_t operand) {
+        gb.writeWord(operand, gb.registers.sp);
+        return 20;
+    }
+
+    static int ldSPHL(GameBoyEmulator& gb, uint16_t) {
+        gb.registers.sp = gb.registers.hl;
+        return 8;
+    }
+
+    static int ldHLSPd(GameBoyEmulator& gb, uint16_t operand) {
+        gb.registers.hl = gb.addSP(static_cast<int8_t>(operand));
+        return 12;
+    }
+
+    static int addSPd(GameBoyEmulator& gb, uint16_t operand) {
+        gb.registers.sp = gb.addSP(static_cast<int8_t>(operand));
+        return 16;
+    }
+
+    template <uint8_t P>
+    static int inc16(GameBoyEmulator& gb, uint16_t) {
+        R16<P>::reg(gb.registers)++;
+        return 8;
+    }
+
+    template <uint8_t P>
+    static int dec16(GameBoyEmulator& gb, uint16_t) {
+        R16<P>::reg(gb.registers)--;
+        return 8;
+    }
+
+    template <uint8_t P>
+    static int addHL(GameBoyEmulator& gb, uint16_t) {
+        gb.registers.hl = gb.add16(gb.registers.hl, R16<P>::reg(gb.registers));
+        return 8;
+    }
+
+    template <uint8_t P>
+    static int push(GameBoyEmulator& gb, uint16_t) {
+        gb.pushWord(R16Stack<P>::read(gb));
+        return 16;
+    }
+
+    template <uint8_t P>
+    static int pop(GameBoyEmulator& gb, uint16_t) {
+        R16Stack<P>::write(gb, gb.popWord());
+        return 12;
+    }
+
+    // 8-bit arithmetic
+    template <class R>
+    static int inc(GameBoyEmulator& gb, uint16_t) {
+        R::write(gb, gb.inc(R::read(gb)));
+        return 4 + R::cycles * 2;
+    }
+
+    template <class R>
+    static int dec(GameBoyEmulator& gb, uint16_t) {
+        R::write(gb, gb.dec(R::read(gb)));
+        return 4 + R::cycles * 2;
+    }
+
+    template <uint8_t Y>
+    static void alu(GameBoyEmulator& gb, uint8_t value) {
+        if constexpr (Y == 0) gb.add8(value);
+        else if constexpr (Y == 1) gb.adc8(value);
+        else if constexpr (Y == 2) gb.sub8(value);
+        else if constexpr (Y == 3) gb.sbc8(value);
+        else if constexpr (Y == 4) gb.and8(value);
+        else if constexpr (Y == 5) gb.xor8(value);
+        else if constexpr (Y == 6) gb.or8(value);
+        else gb.cp8(value);
+    }
+
+    template <uint8_t Y, class Src>
+    static int aluReg(GameBoyEmulator& gb, uint16_t) {
+        alu<Y>(gb, Src::read(gb));
+        return 4 + Src::cycles;
+    }
+
+    template <uint8_t Y>
+    static int aluImm(GameBoyEmulator& gb, uint16_t operand) {
+        alu<Y>(gb, static_cast<uint8_t>(operand));
+        return 8;
+    }
+
+    // RLCA RRCA RLA RRA DAA CPL SCF CCF
+    template <uint8_t Y>
+    static int accumulatorOp(GameBoyEmulator& gb, uint16_t) {
+        auto& r = gb.registers;
+        if constexpr (Y == 0) { r.a = gb.rlc(r.a); gb.setZeroFlag(false); }
+        else if constexpr (Y == 1) { r.a = gb.rrc(r.a); gb.setZeroFlag(false); }
+        else if constexpr (Y == 2) { r.a = gb.rl(r.a); gb.setZeroFlag(false); }
+        else if constexpr (Y == 3) { r.a = gb.rr(r.a); gb.setZeroFlag(false); }
+        else if constexpr (Y == 4) { gb.daa(); }
+        else if constexpr (Y == 5) {
+            r.a = ~r.a;
+            gb.setSubtractFlag(true);
+            gb.setHalfCarryFlag(true);
+        }
+        else if constexpr (Y == 6) {
+            gb.setSubtractFlag(false);
+            gb.setHalfCarryFlag(false);
+            gb.setCarryFlag(true);
+        }
+        else {
+            gb.setSubtractFlag(false);
+            gb.setHalfCarryFlag(false);
+            gb.setCarryFlag(!gb.getCarryFlag());
+        }
+        return 4;
+    }
+
+    // Control flow
+    template <class C>
+    static int jr(GameBoyEmulator& gb, uint16_t operand) {
+        if (!C::test(gb)) return 8;
+        gb.registers.pc += static_cast<int8_t>(operand);
+        return 12;
+    }
+
+    template <class C>
+    static int jp(GameBoyEmulator& gb, uint16_t operand) {
+        if (!C::test(gb)) return 12;
+        gb.registers.pc = operand;
+        return 16;
+    }
+
+    static int jpHL(GameBoyEmulator& gb, uint16_t) {
+        gb.registers.pc = gb.registers.hl;
+        return 4;
+    }
+
+    template <class C>
+    static int call(GameBoyEmulator& gb, uint16_t operand) {
+        if (!C::test(gb)) return 12;
+        gb.pushWord(gb.registers.pc);
+        gb.registers.pc = operand;
+        return 24;
+    }
+
+    template <class C>
+    static int retCond(GameBoyEmulator& gb, uint16_t) {
+        if (!C::test(gb)) return 8;
+        gb.registers.pc = gb.popWord();
+        return 20;
+    }
+
+    static int ret(GameBoyEmulator& gb, uint16_t) {
+        gb.registers.pc = gb.popWord();
+        return 16;
+    }
+
+    static int reti(GameBoyEmulator& gb, uint16_t) {
+        gb.registers.pc = gb.popWord();
+        gb.interrupts.master = true;
+        return 16;
+    }
+
+    template <uint8_t Y>
+    static int rst(GameBoyEmulator& gb, uint16_t) {
+        gb.pushWord(gb.registers.pc);
+        gb.registers.pc = Y * 8;
+        return 16;
+    }
+
+    // CB-prefixed: rotates/shifts, BIT, RES, SET
+    template <uint8_t Y, class R>
+    static int cbShift(GameBoyEmulator& gb, uint16_t) {
+        uint8_t value = R::read(gb);
+        if constexpr (Y == 0) value = gb.rlc(value);
+        else if constexpr (Y == 1) value = gb.rrc(value);
+        else if constexpr (Y == 2) value = gb.rl(value);
+        else if constexpr (Y == 3) value = gb.rr(value);
+        else if constexpr (Y == 4) value = gb.sla(value);
+        else if constexpr (Y == 5) value = gb.sra(value);
+        else if constexpr (Y == 6) value = gb.swap(value);
+        else value = gb.srl(value);
+        R::write(gb, value);
+        return 8 + R::cycles * 2;
+    }
+
+    template <uint8_t Bit, class R>
+    static int cbBit(GameBoyEmulator& gb, uint16_t) {
+        gb.bit(Bit, R::read(gb));
+        return 8 + R::cycles;
+    }
+
+    template <uint8_t Bit, class R>
+    static int cbRes(GameBoyEmulator& gb, uint16_t) {
+        R::write(gb, R::read(gb) & static_cast<uint8_t>(~(1u << Bit)));
+        return 8 + R::cycles * 2;
+    }
+
+    template <uint8_t Bit, class R>
+    static int cbSet(GameBoyEmulator& gb, uint16_t) {
+        R::write(gb, R::read(gb) | static_cast<uint8_t>(1u << Bit));
+        return 8 + R::cycles * 2;
+    }
+
+    // Table generation
+    template <uint8_t Op>
+    static constexpr Handler decode() {
+        constexpr uint8_t x = Op >> 6;
+        constexpr uint8_t y = (Op >> 3) & 7;
+        constexpr uint8_t z = Op & 7;
+        constexpr uint8_t p = y >> 1;
+        constexpr uint8_t q = y & 1;
+
+        if constexpr (SM83::isUnknownOpcode(Op)) {
+            return &unknown;
+        } else if constexpr (x == 0) {
+            if constexpr (z == 0) {
+                if constexpr (y == 0) return &nop;
+                else if constexpr (y == 1) return &ldNNSP;
+                else if constexpr (y == 2) return &stop;
+                else if constexpr (y == 3) return &jr<Always>;
+                else return &jr<Cond<y - 4>>;
+            }
+            else if constexpr (z == 1) {
+                if constexpr (q == 0) return &ld16<p>;
+                else return &addHL<p>;
+            }
+            else if constexpr (z == 2) {
+                if constexpr (q == 0) return &ldIndirectA<p>;
+                else return &ldAIndirect<p>;
+            }
+            else if constexpr (z == 3) {
+                if constexpr (q == 0) return &inc16<p>;
+                else return &dec16<p>;
+            }
+            else if constexpr (z == 4) return &inc<R8<y>>;
+            else if constexpr (z == 5) return &dec<R8<y>>;
+            else if constexpr (z == 6) return &ldImm<R8<y>>;
+            else return &accumulatorOp<y>;
+        } else if constexpr (x == 1) {
+            if constexpr (Op == 0x76) return &halt;
+            else return &ld<R8<y>, R8<z>>;
+        } else if constexpr (x == 2) {
+            return &aluReg<y, R8<z>>;
+        } else {
+            if constexpr (z == 0) {
+                if constexpr (y < 4) return &retCond<Cond<y>>;
+                else if constexpr (y == 4) return &ldhNA;
+                else if constexpr (y == 5) return &addSPd;
+                else if constexpr (y == 6) return &ldhAN;
+                else return &ldHLSPd;
+            }
+            else if constexpr (z == 1) {
+                if constexpr (q == 0) return &pop<p>;
+                else if constexpr (p == 0) return &ret;
+                else if constexpr (p == 1) return &reti;
+                else if constexpr (p == 2) return &jpHL;
+                else return &ldSPHL;
+            }
+            else if constexpr (z == 2) {
+                if constexpr (y < 4) return &jp<Cond<y>>;
+                else if constexpr (y == 4) return &ldhCA;
+                else if constexpr (y == 5) return &ldNNA;
+                else if constexpr (y == 6) return &ldhAC;
+                else return &ldANN;
+            }
+            else if constexpr (z == 3) {
+                if constexpr (y == 0) return &jp<Always>;
+                else if constexpr (y == 1) return &cbPrefix;
+                else if constexpr (y == 6) return &di;
+                else return &ei;
+            }
+            else if constexpr (z == 4) return &call<Cond<y>>;
+            else if constexpr (z == 5) {
+                if constexpr (q == 0) return &push<p>;
+                else return &call<Always>;
+            }
+            else if constexpr (z == 6) return &aluImm<y>;
+            else return &rst<y>;
+        }
+    }
+
+    template <uint8_t Op>
+    static constexpr Handler decodeCB() {
+        constexpr uint8_t x = Op >> 6;
+        constexpr uint8_t y = (Op >> 3) & 7;
+        constexpr uint8_t z = Op & 7;
+
+        if constexpr (x == 0) return &cbShift<y, R8<z>>;
+        else if constexpr (x == 1) return &cbBit<y, R8<z>>;
+        else if constexpr (x == 2) return &cbRes<y, R8<z>>;
+        else return &cbSet<y, R8<z>>;
+    }
+
+    template <std::size_t... Opcodes>
+    static constexpr std::array<Handler, 256> makeTable(std::index_sequence<Opcodes...>) {
+        return {{ decode<static_cast<uint8_t>(Opcodes)>()... }};
+    }
+
+    template <std::size_t... Opcodes>
+    static constexpr std::array<Handler, 256> makeCBTable(std::index_sequence<Opcodes...>) {
+        return {{ decodeCB<static_cast<uint8_t>(Opcodes)>()... }};
+    }
+};
+
+const std::array<SM83::Handler, 256> SM83::opcodeTable =
+    SM83::Ops::makeTable(std::make_index_sequence<256>{});
+
+const std::array<SM83::Handler, 256> SM83::cbOpcodeTable =
+    SM83::Ops::makeCBTable(std::make_index_sequence<256>{});
+
+// Disassembly uses the same x/y/z decomposition as the handler tables
+std::string SM83::disassemble(uint16_t address, uint8_t opcode, uint16_t operand) {
+    static const char* const R[] = {"B", "C", "D", "E", "H", "L", "(HL)", "A"};
+    static const char* const RP[] = {"BC", "DE", "HL", "SP"};
+    static const char* const RP2[] = {"BC", "DE", "HL", "AF"};
+    static const char* const CC[] = {"NZ", "Z", "NC", "C"};
+    static const char* const ALU[] = {"ADD A,", "ADC A,", "SUB ", "SBC A,", "AND ", "XOR ", "OR ", "CP "};
+    static const char* const ROT[] = {"RLC", "RRC", "RL", "RR", "SLA", "SRA", "SWAP", "SRL"};
+    static const char* const MISC[] = {"RLCA", "RRCA", "RLA", "RRA", "DAA", "CPL", "SCF", "CCF"};
+
+    const uint8_t x = opcode >> 6;
+    const uint8_t y = (opcode >> 3) & 7;
+    const uint8_t z = opcode & 7;
+    const uint8_t p = y >> 1;
+    const bool q = y & 1;
+    const uint16_t relative = static_cast<uint16_t>(address + 2 + static_cast<int8_t>(operand));
+
+    char text[32];
+    auto format = [&text](const char* pattern, auto... args) {
+        std::snprintf(text, sizeof(text), pattern, args...);
+        return std::string(text);
+    };
+
+    if (isUnknownOpcode(opcode)) {
+        return format("DB $%02X", opcode);
+    }
+
+    if (x == 0) {
+        switch (z) {
+            case 0:
+                if (y == 0) return "NOP";
+                if (y == 1) return format("LD ($%04X),SP", operand);
+                if (y == 2) return "STOP";
+                if (y == 3) return format("JR $%04X", relative);
+                return format("JR %s,$%04X", CC[y - 4], relative);
+            case 1:
+                return q ? format("ADD HL,%s", RP[p]) : format("LD %s,$%04X", RP[p], operand);
+            case 2: {
+                static const char* const INDIRECT[] = {"(BC)", "(DE)", "(HL+)", "(HL-)"};
+                return q ? format("LD A,%s", INDIRECT[p]) : format("LD %s,A", INDIRECT[p]);
+            }
+            case 3:
+                return format("%s %s", q ? "DEC" : "INC", RP[p]);
+            case 4:
+                return format("INC %s", R[y]);
+            case 5:
+                return format("DEC %s", R[y]);
+            case 6:
+                return format("LD %s,$%02X", R[y], operand);
+            default:
+                return MISC[y];
+        }
+    }
+
+    if (x == 1) {
+        return opcode == 0x76 ? "HALT" : format("LD %s,%s", R[y], R[z]);
+    }
+
+    if (x == 2) {
+        return format("%s%s", ALU[y], R[z]);
+    }
+
+    switch (z) {
+        case 0:
+            if (y < 4) return format("RET %s", CC[y]);
+            if (y == 4) return format("LDH ($%02X),A", operand);
+            if (y == 5) return format("ADD SP,%d", static_cast<int8_t>(operand));
+            if (y == 6) return format("LDH A,($%02X)", operand);
+            return format("LD HL,SP%+d", static_cast<int8_t>(operand));
+        case 1:
+            if (!q) return format("POP %s", RP2[p]);
+            if (p == 0) return "RET";
+            if (p == 1) return "RETI";
+            if (p == 2) return "JP HL";
+            return "LD SP,HL";
+        case 2:
+            if (y < 4) return format("JP %s,$%04X", CC[y], operand);
+            if (y == 4) return "LD (C),A";
+            if (y == 5) return format("LD ($%04X),A", operand);
+            if (y == 6) return "LD A,(C)";
+            return format("LD A,($%04X)", operand);
+        case 3:
+            if (y == 0) return format("JP $%04X", operand);
+            if (y == 6) return "DI";
+            if (y == 7) return "EI";
+            {
+                // CB prefix; the sub-opcode is the operand
+                uint8_t cb = operand & 0xFF;
+                uint8_t cbX = cb >> 6;
+                uint8_t cbY = (cb >> 3) & 7;
+                const char* reg = R[cb & 7];
+                if (cbX == 0) return format("%s %s", ROT[cbY], reg);
+                static const char* const BIT_OPS[] = {"", "BIT", "RES", "SET"};
+                return format("%s %d,%s", BIT_OPS[cbX], cbY, reg);
+            }
+        case 4:
+            return format("CALL %s,$%04X", CC[y], operand);
+        case 5:
+            return q ? format("CALL $%04X", operand) : format("PUSH %s", RP2[p]);
+        case 6:
+            return format("%s$%02X", ALU[y], operand);
+        default:
+            return format("RST $%02X", y * 8);
+    }
+}
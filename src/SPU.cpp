@@ -6,7 +6,7 @@
 SPU::SPU(bool isPS2) : isPS2Mode(isPS2) {
     // Initialize vectors with appropriate sizes
     voices.resize(isPS2 ? PS2_VOICE_COUNT : PS1_VOICE_COUNT);
-    spuRam.resize(isPS2 ? SPU_RAM_SIZE * 2 : SPU_RAM_SIZE);  // PS2 has double the SPU RAM
+    spuRam.assign(isPS2 ? SPU_RAM_SIZE * 2 : SPU_RAM_SIZE);  // PS2 has double the SPU RAM
     audioBuffer.reserve(44100 * 2);  // Reserve space for 1 second of stereo audio at 44.1kHz
 
     initialize();
@@ -34,7 +34,7 @@ void SPU::initialize() {
     }
 
     // Clear SPU RAM
-    std::fill(spuRam.begin(), spuRam.end(), 0);
+    spuRam.fill(0);
 }
 
 void SPU::reset() {
@@ -70,7 +70,7 @@ void SPU::processVoice(uint8_t voiceIndex) {
 
     // Read sample data from SPU RAM
     uint32_t addr = voice.currentAddr & (spuRam.size() - 1);
-    int16_t sample = static_cast<int16_t>((spuRam[addr + 1] << 8) | spuRam[addr]);
+    int16_t sample = static_cast<int16_t>((spuRam.read((addr + 1) & (spuRam.size() - 1)) << 8) | spuRam.read(addr));
 
     // Apply ADSR volume
     sample = static_cast<int16_t>((static_cast<int32_t>(sample) * voice.adsrVolume) >> 15);
@@ -98,10 +98,10 @@ void SPU::updateADSR(Voice& voice) {
     // Simple ADSR implementation
     if (voice.keyOn) {
         // Attack phase
-        voice.adsrVolume = std::min(voice.adsrVolume + (voice.adsr1 >> 8), 0x7FFFu);
+        voice.adsrVolume = static_cast<uint16_t>(std::min(voice.adsrVolume + (voice.adsr1 >> 8), 0x7FFF));
     } else if (voice.keyOff) {
-        // Release phase
-        voice.adsrVolume = std::max(voice.adsrVolume - (voice.adsr2 & 0xFF), 0u);
+        // Release phase (signed, so the clamp catches the underflow)
+        voice.adsrVolume = static_cast<uint16_t>(std::max(voice.adsrVolume - (voice.adsr2 & 0xFF), 0));
     }
 }
 
@@ -128,14 +128,14 @@ void SPU::checkIRQ() {
 uint16_t SPU::read(uint32_t address) const {
     address &= (spuRam.size() - 1);
     if (address + 1 >= spuRam.size()) return 0;
-    return (spuRam[address + 1] << 8) | spuRam[address];
+    return (spuRam.read(address + 1) << 8) | spuRam.read(address);
 }
 
 void SPU::write(uint32_t address, uint16_t value) {
     address &= (spuRam.size() - 1);
     if (address + 1 >= spuRam.size()) return;
-    spuRam[address] = value & 0xFF;
-    spuRam[address + 1] = (value >> 8) & 0xFF;
+    spuRam.write(address, value & 0xFF);
+    spuRam.write(address + 1, (value >> 8) & 0xFF);
 }
 
 bool SPU::saveState(const std::string& filepath) {
@@ -156,7 +156,9 @@ bool SPU::saveState(const std::string& filepath) {
     }
 
     // Save SPU RAM
-    file.write(reinterpret_cast<const char*>(spuRam.data()), spuRam.size());
+    std::vector<uint8_t> snapshot(spuRam.size());
+    spuRam.copyTo(snapshot.data());
+    file.write(reinterpret_cast<const char*>(snapshot.data()), snapshot.size());
 
     return true;
 }
@@ -179,7 +181,9 @@ bool SPU::loadState(const std::string& filepath) {
     }
 
     // Load SPU RAM
-    file.read(reinterpret_cast<char*>(spuRam.data()), spuRam.size());
+    std::vector<uint8_t> snapshot(spuRam.size());
+    file.read(reinterpret_cast<char*>(snapshot.data()), snapshot.size());
+    spuRam.copyFrom(snapshot.data());
 
     return true;
 } 
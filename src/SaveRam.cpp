@@ -0,0 +1,158 @@
+#include "SaveRam.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+SaveRam::~SaveRam() {
+    if (isOpen()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        writer.join();
+    }
+}
+
+bool SaveRam::open(const std::string& filepath, CowMemory& ram) {
+    close(ram);
+    if (ram.size() == 0) {
+        return false;
+    }
+
+    std::vector<uint8_t> data(ram.size());
+    ram.copyTo(data.data());
+    std::ifstream in(filepath, std::ios::binary);
+    if (in) {
+        in.read(reinterpret_cast<char*>(data.data()), data.size());
+        ram.copyFrom(data.data());
+    }
+    bool complete = in && static_cast<size_t>(in.gcount()) == data.size();
+    in.close();
+
+    // Make sure the file exists so the writer can update it in place
+    if (!complete) {
+        std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    path = filepath;
+    size_t pages = (ram.size() + PAGE_SIZE - 1) / PAGE_SIZE;
+    dirty.assign(pages, 0);
+    anyDirty = false;
+    staged.assign(ram.size(), 0);
+    stagedPages.assign(pages, 0);
+    pending = false;
+    stopping = false;
+    lastCommit = std::chrono::steady_clock::now();
+    writer = std::thread(&SaveRam::run, this);
+    return true;
+}
+
+void SaveRam::close(const CowMemory& ram) {
+    if (!isOpen()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (anyDirty) {
+            stage(ram);
+        }
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+}
+
+void SaveRam::markAllDirty() {
+    std::fill(dirty.begin(), dirty.end(), 1);
+    anyDirty = !dirty.empty();
+}
+
+bool SaveRam::commit(const CowMemory& ram, bool force) {
+    if (!anyDirty || !isOpen()) {
+        return false;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (!force && now - lastCommit < FLUSH_INTERVAL) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if (force) {
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        return false;
+    }
+    stage(ram);
+    lastCommit = now;
+    lock.unlock();
+    wake.notify_one();
+    return true;
+}
+
+// Called with the mutex held
+void SaveRam::stage(const CowMemory& ram) {
+    for (size_t page = 0; page < dirty.size(); page++) {
+        if (dirty[page]) {
+            // Our pages never straddle one of the memory's, which are larger
+            size_t offset = page * PAGE_SIZE;
+            size_t length = std::min(PAGE_SIZE, ram.size() - offset);
+            const uint8_t* source = ram.readPointer(offset) + (offset & (ram.pageSize() - 1));
+            std::memcpy(staged.data() + offset, source, length);
+            stagedPages[page] = 1;
+            dirty[page] = 0;
+        }
+    }
+    anyDirty = false;
+    pending = true;
+}
+
+void SaveRam::run() {
+    std::vector<uint8_t> buffer(staged.size());
+    std::vector<uint8_t> pages(stagedPages.size());
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this] { return pending || stopping; });
+        if (!pending) {
+            break;
+        }
+
+        // Take the staged pages and write them without holding the lock
+        for (size_t page = 0; page < pages.size(); page++) {
+            pages[page] = stagedPages[page];
+            if (pages[page]) {
+                size_t offset = page * PAGE_SIZE;
+                size_t length = std::min(PAGE_SIZE, staged.size() - offset);
+                std::memcpy(buffer.data() + offset, staged.data() + offset, length);
+                stagedPages[page] = 0;
+            }
+        }
+        pending = false;
+        lock.unlock();
+
+        for (size_t page = 0; page < pages.size(); page++) {
+            if (!pages[page]) {
+                continue;
+            }
+            // Coalesce runs of dirty pages into one write
+            size_t last = page;
+            while (last + 1 < pages.size() && pages[last + 1]) {
+                last++;
+            }
+            size_t offset = page * PAGE_SIZE;
+            size_t length = std::min((last + 1) * PAGE_SIZE, buffer.size()) - offset;
+            file.seekp(offset);
+            file.write(reinterpret_cast<const char*>(buffer.data() + offset), length);
+            page = last;
+        }
+        file.flush();
+
+        lock.lock();
+    }
+}
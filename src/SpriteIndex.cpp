@@ -0,0 +1,54 @@
+#include "SpriteIndex.hpp"
+#include <algorithm>
+
+SpriteIndex::SpriteIndex() : tall(false) {
+    lines.fill(0);
+    top.fill(0);
+}
+
+void SpriteIndex::update(int sprite, const uint8_t* oam, bool tallSprites) {
+    if (tallSprites != tall) {
+        rebuild(oam, tallSprites);
+        return;
+    }
+    setLines(sprite, false);
+    top[sprite] = oam[sprite * 4];
+    setLines(sprite, true);
+}
+
+void SpriteIndex::rebuild(const uint8_t* oam, bool tallSprites) {
+    tall = tallSprites;
+    lines.fill(0);
+    for (int sprite = 0; sprite < SPRITE_COUNT; sprite++) {
+        top[sprite] = oam[sprite * 4];
+        setLines(sprite, true);
+    }
+}
+
+// OAM Y is the screen line plus 16
+void SpriteIndex::setLines(int sprite, bool present) {
+    int first = top[sprite] - 16;
+    int end = std::min(first + (tall ? 16 : 8), LINE_COUNT);
+    uint64_t bit = 1ull << sprite;
+    for (int line = std::max(first, 0); line < end; line++) {
+        if (present) {
+            lines[line] |= bit;
+        } else {
+            lines[line] &= ~bit;
+        }
+    }
+}
+
+int SpriteIndex::select(int line, uint8_t* out, int limit) const {
+    if (line < 0 || line >= LINE_COUNT) {
+        return 0;
+    }
+    int count = 0;
+    uint64_t mask = lines[line];
+    for (int sprite = 0; mask && count < limit; sprite++, mask >>= 1) {
+        if (mask & 1) {
+            out[count++] = static_cast<uint8_t>(sprite);
+        }
+    }
+    return count;
+}
@@ -0,0 +1,11 @@
+#include "TileCache.hpp"
+#include "PixelKernels.hpp"
+
+TileCache::TileCache() {
+    markAllDirty();
+}
+
+void TileCache::decode(int index, const uint8_t* data) {
+    PixelKernels::decode2bpp(data, 8, rows[index][0].data());
+    dirty[index] = false;
+}
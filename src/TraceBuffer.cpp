@@ -0,0 +1,213 @@
+#include "TraceBuffer.hpp"
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+enum : uint8_t {
+    CHANGED_PC = 1 << 0,
+    CHANGED_AF = 1 << 1,
+    CHANGED_BC = 1 << 2,
+    CHANGED_DE = 1 << 3,
+    CHANGED_HL = 1 << 4,
+    CHANGED_SP = 1 << 5
+};
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void putWord(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(value & 0xFF);
+    out.push_back(value >> 8);
+}
+
+void putWord32(std::vector<uint8_t>& out, uint32_t value) {
+    putWord(out, value & 0xFFFF);
+    putWord(out, value >> 16);
+}
+
+// Bounds-checked cursor over one encoded chunk
+struct Reader {
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+
+    bool byte(uint8_t& value) {
+        if (position >= size) {
+            return false;
+        }
+        value = data[position++];
+        return true;
+    }
+
+    bool word(uint16_t& value) {
+        uint8_t low, high;
+        if (!byte(low) || !byte(high)) {
+            return false;
+        }
+        value = low | (high << 8);
+        return true;
+    }
+
+    bool varint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t part;
+            if (!byte(part)) {
+                return false;
+            }
+            value |= static_cast<uint64_t>(part & 0x7F) << shift;
+            if (!(part & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace
+
+TraceBuffer::TraceBuffer(size_t capacity) : head(0), count(0), file(nullptr) {
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    ring.resize(size);
+    pending.reserve(CHUNK_RECORDS);
+}
+
+TraceBuffer::~TraceBuffer() {
+    close();
+}
+
+void TraceBuffer::clear() {
+    head = 0;
+    count = 0;
+}
+
+bool TraceBuffer::open(const std::string& filepath) {
+    close();
+    file = std::fopen(filepath.c_str(), "wb");
+    return file != nullptr;
+}
+
+void TraceBuffer::close() {
+    if (!file) {
+        return;
+    }
+    flushChunk();
+    std::fclose(file);
+    file = nullptr;
+}
+
+void TraceBuffer::flushChunk() {
+    if (pending.empty()) {
+        return;
+    }
+
+    encoded.clear();
+    TraceRecord previous = {};
+    for (const TraceRecord& entry : pending) {
+        uint8_t flags = static_cast<uint8_t>(entry.length << 6);
+        if (entry.pc != static_cast<uint16_t>(previous.pc + previous.length)) flags |= CHANGED_PC;
+        if (entry.af != previous.af) flags |= CHANGED_AF;
+        if (entry.bc != previous.bc) flags |= CHANGED_BC;
+        if (entry.de != previous.de) flags |= CHANGED_DE;
+        if (entry.hl != previous.hl) flags |= CHANGED_HL;
+        if (entry.sp != previous.sp) flags |= CHANGED_SP;
+
+        encoded.push_back(flags);
+        putVarint(encoded, entry.cycle - previous.cycle);
+        if (flags & CHANGED_PC) putWord(encoded, entry.pc);
+        encoded.insert(encoded.end(), entry.opcode, entry.opcode + entry.length);
+        if (flags & CHANGED_AF) putWord(encoded, entry.af);
+        if (flags & CHANGED_BC) putWord(encoded, entry.bc);
+        if (flags & CHANGED_DE) putWord(encoded, entry.de);
+        if (flags & CHANGED_HL) putWord(encoded, entry.hl);
+        if (flags & CHANGED_SP) putWord(encoded, entry.sp);
+        previous = entry;
+    }
+
+    std::vector<uint8_t> header;
+    putWord32(header, static_cast<uint32_t>(pending.size()));
+    putWord32(header, static_cast<uint32_t>(encoded.size()));
+    std::fwrite(header.data(), 1, header.size(), file);
+    std::fwrite(encoded.data(), 1, encoded.size(), file);
+    pending.clear();
+}
+
+bool TraceBuffer::readFile(const std::string& filepath, std::vector<TraceRecord>& records) {
+    std::FILE* input = std::fopen(filepath.c_str(), "rb");
+    if (!input) {
+        return false;
+    }
+
+    bool ok = true;
+    std::vector<uint8_t> chunk;
+    uint8_t header[8];
+    while (ok && std::fread(header, 1, sizeof(header), input) == sizeof(header)) {
+        uint32_t recordCount = header[0] | (header[1] << 8) | (header[2] << 16) | (static_cast<uint32_t>(header[3]) << 24);
+        uint32_t byteCount = header[4] | (header[5] << 8) | (header[6] << 16) | (static_cast<uint32_t>(header[7]) << 24);
+        chunk.resize(byteCount);
+        if (std::fread(chunk.data(), 1, byteCount, input) != byteCount) {
+            ok = false;
+            break;
+        }
+
+        Reader reader{chunk.data(), chunk.size(), 0};
+        TraceRecord previous = {};
+        for (uint32_t i = 0; i < recordCount && ok; i++) {
+            TraceRecord entry = previous;
+            uint8_t flags;
+            uint64_t cycleDelta;
+            ok = reader.byte(flags) && reader.varint(cycleDelta);
+            entry.cycle = previous.cycle + cycleDelta;
+            entry.length = flags >> 6;
+            entry.pc = previous.pc + previous.length;
+            if (ok && (flags & CHANGED_PC)) ok = reader.word(entry.pc);
+            for (uint8_t b = 0; b < 3; b++) {
+                entry.opcode[b] = 0;
+            }
+            for (uint8_t b = 0; ok && b < entry.length && b < 3; b++) {
+                ok = reader.byte(entry.opcode[b]);
+            }
+            if (ok && (flags & CHANGED_AF)) ok = reader.word(entry.af);
+            if (ok && (flags & CHANGED_BC)) ok = reader.word(entry.bc);
+            if (ok && (flags & CHANGED_DE)) ok = reader.word(entry.de);
+            if (ok && (flags & CHANGED_HL)) ok = reader.word(entry.hl);
+            if (ok && (flags & CHANGED_SP)) ok = reader.word(entry.sp);
+            if (ok) {
+                records.push_back(entry);
+                previous = entry;
+            }
+        }
+    }
+
+    std::fclose(input);
+    return ok;
+}
+
+std::string TraceBuffer::format(const TraceRecord& entry) {
+    std::ostringstream ss;
+    ss << std::hex << std::uppercase << std::setfill('0');
+    ss << std::setw(4) << entry.pc << ": ";
+    for (uint8_t i = 0; i < 3; i++) {
+        if (i < entry.length) {
+            ss << std::setw(2) << static_cast<int>(entry.opcode[i]) << ' ';
+        } else {
+            ss << "   ";
+        }
+    }
+    ss << " AF=" << std::setw(4) << entry.af
+       << " BC=" << std::setw(4) << entry.bc
+       << " DE=" << std::setw(4) << entry.de
+       << " HL=" << std::setw(4) << entry.hl
+       << " SP=" << std::setw(4) << entry.sp
+       << std::dec << " CY=" << entry.cycle;
+    return ss.str();
+}
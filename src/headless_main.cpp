@@ -0,0 +1,46 @@
+#include "Emulator.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Headless runner: no window, audio device or input polling. Frames are
+// run back to back with no frame limiter, for batch and server use.
+
+void printUsage() {
+    std::cout << "Usage: retronexus_headless <filename> [frames]\n";
+    std::cout << "Runs the given number of frames (default 3600) as fast as possible\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        printUsage();
+        return 1;
+    }
+
+    uint32_t frames = argc == 3 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 3600;
+
+    try {
+        Emulator emu;
+        std::string filepath = argv[1];
+
+        if (!emu.loadFile(filepath)) {
+            std::cerr << "Failed to load file\n";
+            return 1;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        emu.runFrames(frames);
+        auto end = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        std::cout << "Ran " << frames << " frames in " << seconds << "s ("
+                  << (seconds > 0 ? frames / seconds : 0) << " fps)\n";
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}